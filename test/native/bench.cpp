@@ -0,0 +1,42 @@
+/*
+ * Host runner for the effect benchmark (benchmark.cpp)
+ * Usage: wled_bench [n=<frames>] [fx=<effect id>] [g=<geometry mask>] [cmp] [json]
+ * Arguments are the same as /json/bench query parameters, results are printed as CSV (or JSON).
+ */
+
+int main(int argc, char *argv[]) {
+  nativeBegin(300);
+
+  AsyncWebServerRequest start;
+  start.addParam("run");
+  bool json = false;
+  for (int i = 1; i < argc; i++) {
+    const char *eq = strchr(argv[i], '=');
+    if (!strcmp(argv[i], "json")) json = true;
+    else if (eq) start.addParam(std::string(argv[i], eq - argv[i]), eq + 1);
+    else         start.addParam(argv[i]);
+  }
+
+  FILE *devNull = fopen("/dev/null", "w"); // response to start request only reports state
+  AsyncWebServerRequest *req = new AsyncWebServerRequest(devNull ? devNull : stdout);
+  for (const char *p : {"run", "n", "fx", "g", "cmp"}) {
+    AsyncWebParameter *param = start.getParam(p);
+    if (param) req->addParam(param->name(), param->value());
+  }
+  serveBenchmark(req);
+  const int code = req->code();
+  delete req;
+  if (devNull) fclose(devNull);
+  if (code != 200) {
+    fprintf(stderr, "Benchmark could not be started (%d).\n", code);
+    return 1;
+  }
+
+  while (strip.isSuspended()) handleBenchmark();
+
+  AsyncWebServerRequest results;
+  if (!json) results.addParam("csv");
+  serveBenchmark(&results);
+  if (json) putchar('\n');
+  return 0;
+}
@@ -0,0 +1,176 @@
+/*
+ * Bus manager for host builds: every configured bus is a memory backed bus (BusMemory)
+ * Mirrors the parts of bus_manager.cpp used by the effect engine, without any LED drivers.
+ */
+
+bool ColorOrderMap::add(uint16_t start, uint16_t len, uint8_t colorOrder) {
+  if (count() >= WLED_MAX_COLOR_ORDER_MAPPINGS || len == 0 || (colorOrder & 0x0F) > COL_ORDER_MAX) return false;
+  _mappings.push_back({start,len,colorOrder});
+  return true;
+}
+
+bool Bus::hasChanged(unsigned long now) {
+  bool changed = _needsRefresh || mustRefresh() || _bri != _lastBri || (_keepAlive && now - _lastShow >= _keepAlive);
+  if (_hash != BUS_HASH_SEED) {
+    changed |= _hash != _lastHash;
+    _lastHash = _hash;
+  }
+  if (changed) {
+    _lastBri = _bri;
+    _lastShow = now;
+  }
+  return changed;
+}
+
+uint8_t *Bus::allocateData(size_t size) {
+  if (_data) free(_data);
+  return _data = (uint8_t *)(size>0 ? calloc(size, sizeof(uint8_t)) : nullptr);
+}
+
+
+BusMemory::BusMemory(BusConfig &bc)
+: Bus(bc.type, bc.start, bc.autoWhite, bc.count, bc.reversed)
+{
+  _hasRgb = true;
+  _hasWhite = true;
+  _hasCCT = false;
+  _valid = (allocateData(_len * sizeof(uint32_t)) != nullptr);
+}
+
+void BusMemory::setPixelColor(unsigned pix, uint32_t c) {
+  if (!_valid || pix >= _len) return;
+  if (_reversed) pix = _len - pix - 1;
+  reinterpret_cast<uint32_t*>(_data)[pix] = c;
+}
+
+void BusMemory::setPixelColors(unsigned pix, unsigned count, const uint32_t *c) {
+  if (!_valid || pix >= _len) return;
+  if (count > _len - pix) count = _len - pix;
+  if (_reversed) for (unsigned i = 0; i < count; i++) setPixelColor(pix + i, c[i]);
+  else memcpy(_data + pix * sizeof(uint32_t), c, count * sizeof(uint32_t));
+}
+
+uint32_t BusMemory::getPixelColor(unsigned pix) const {
+  if (!_valid || pix >= _len) return 0;
+  if (_reversed) pix = _len - pix - 1;
+  return reinterpret_cast<const uint32_t*>(_data)[pix];
+}
+
+std::vector<LEDType> BusMemory::getLEDTypes() {
+  return {
+    {TYPE_VIRTUAL_MEMORY, "V",     PSTR("Simulated (no output)")},
+  };
+}
+
+void BusMemory::cleanup() {
+  _type = TYPE_NONE;
+  _valid = false;
+  freeData();
+}
+
+
+uint32_t BusManager::memUsage(BusConfig &bc) {
+  return bc.count * sizeof(uint32_t);
+}
+
+uint32_t BusManager::memUsage(unsigned maxChannels, unsigned maxCount, unsigned minBuses) {
+  return maxCount * minBuses * sizeof(uint32_t);
+}
+
+// any bus type is simulated in memory on host
+int BusManager::add(BusConfig &bc) {
+  if (numBusses >= WLED_MAX_BUSSES) return -1;
+  busses[numBusses] = new BusMemory(bc);
+  numBusses++;
+  return numBusses - 1;
+}
+
+void BusManager::removeAll() {
+  for (unsigned i = 0; i < numBusses; i++) delete busses[i];
+  numBusses = 0;
+}
+
+void BusManager::on()  {}
+void BusManager::off() {}
+
+void BusManager::show() {
+  const unsigned long now = millis();
+  for (unsigned i = 0; i < numBusses; i++) {
+    if (busses[i]->hasChanged(now)) busses[i]->show();
+    busses[i]->resetFrame();
+  }
+}
+
+void BusManager::setStatusPixel(uint32_t c) {}
+
+void BusManager::setPixelColor(unsigned pix, uint32_t c) {
+  for (unsigned i = 0; i < numBusses; i++) {
+    unsigned bstart = busses[i]->getStart();
+    if (pix < bstart || pix >= bstart + busses[i]->getLength()) continue;
+    busses[i]->hashPixel(pix, c);
+    busses[i]->pixelWritten();
+    busses[i]->setPixelColor(pix - bstart, c);
+  }
+}
+
+void BusManager::setPixelColors(unsigned start, unsigned count, const uint32_t *c) {
+  for (unsigned i = 0; i < numBusses; i++) {
+    const unsigned bstart = busses[i]->getStart();
+    const unsigned bend   = bstart + busses[i]->getLength();
+    const unsigned from   = std::max(start, bstart);
+    const unsigned to     = std::min(start + count, bend);
+    if (from >= to) continue;
+    for (unsigned pix = from; pix < to; pix++) busses[i]->hashPixel(pix, c[pix - start]);
+    busses[i]->spanWritten(from - bstart, to - from);
+    busses[i]->setPixelColors(from - bstart, to - from, c + (from - start));
+  }
+}
+
+void BusManager::setBrightness(uint8_t b) {
+  for (unsigned i = 0; i < numBusses; i++) busses[i]->setBrightness(b);
+}
+
+void BusManager::setSegmentCCT(int16_t cct, bool allowWBCorrection) {
+  if (cct > 255) cct = 255;
+  if (cct >= 0) {
+    if (allowWBCorrection) cct = 1900 + (cct << 5);
+  } else cct = -1;
+  Bus::setCCT(cct);
+}
+
+uint32_t BusManager::getPixelColor(unsigned pix) {
+  for (unsigned i = 0; i < numBusses; i++) {
+    if (!busses[i]->containsPixel(pix)) continue;
+    return busses[i]->getPixelColor(pix - busses[i]->getStart());
+  }
+  return 0;
+}
+
+bool BusManager::canAllShow() { return true; }
+
+Bus* BusManager::getBus(uint8_t busNr) {
+  if (busNr >= numBusses) return nullptr;
+  return busses[busNr];
+}
+
+uint16_t BusManager::getTotalLength() {
+  unsigned len = 0;
+  for (unsigned i = 0; i < numBusses; i++) len += busses[i]->getLength();
+  return len;
+}
+
+int16_t Bus::_cct = -1;
+uint8_t Bus::_cctBlend = 0;
+uint8_t Bus::_gAWM = 255;
+
+uint8_t       BusManager::numBusses = 0;
+Bus*          BusManager::busses[WLED_MAX_BUSSES+WLED_MIN_VIRTUAL_BUSSES];
+ColorOrderMap BusManager::colorOrderMap = {};
+uint16_t      BusManager::_milliAmpsUsed = 0;
+uint16_t      BusManager::_milliAmpsHistory[BUS_CURRENT_HISTORY] = {0};
+uint8_t       BusManager::_historyIndex = 0;
+unsigned long BusManager::_lastSample = 0;
+uint16_t      BusManager::_milliAmpsMax = ABL_MILLIAMPS_DEFAULT;
+uint8_t*      BusManager::_pixelBus = nullptr;
+uint16_t      BusManager::_pixelBusLen = 0;
+uint8_t       BusManager::_parallelOutputs = 1;
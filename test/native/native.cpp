@@ -0,0 +1,117 @@
+/*
+ * Host (native) runtime: Arduino core functions, wled.h globals and stubs for firmware parts
+ * that are not part of the native build (web server, pins, file system)
+ */
+#include <chrono>
+#include <thread>
+
+HardwareSerial Serial;
+EspClass       ESP;
+NativeFS       nativeFS;
+
+// ---- time ----
+static const auto     timeStart  = std::chrono::steady_clock::now();
+static unsigned long  timeOffset = 0; // us added by nativeAdvanceTime()
+
+unsigned long micros() {
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - timeStart).count();
+  return (unsigned long)us + timeOffset;
+}
+unsigned long millis()                  { return micros() / 1000; }
+void delay(unsigned long ms)            { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+void delayMicroseconds(unsigned int us) { std::this_thread::sleep_for(std::chrono::microseconds(us)); }
+void yield()                            {}
+void nativeAdvanceTime(unsigned long ms) { timeOffset += ms * 1000UL; }
+
+uint32_t get_millisecond_timer() { return strip.now; } // same as led.cpp
+
+// ---- random numbers (stand-in for the hardware RNG, repeatable between runs) ----
+static uint32_t rndState = 0x2545F491;
+
+uint32_t nativeRandom32() {
+  rndState ^= rndState << 13; // xorshift32
+  rndState ^= rndState >> 17;
+  rndState ^= rndState << 5;
+  return rndState;
+}
+void randomSeed(unsigned long seed)      { if (seed) rndState = seed; }
+long random(long howbig)                 { return howbig > 0 ? nativeRandom32() % howbig : 0; }
+long random(long howsmall, long howbig)  { return howsmall >= howbig ? howsmall : howsmall + random(howbig - howsmall); }
+
+// ---- wled.h globals (default values) ----
+bool     gammaCorrectCol          = true;
+bool     gammaCorrectBri          = false;
+float    gammaCorrectVal          = 2.8f;
+byte     lastRandomIndex          = 0;
+bool     fadeTransition           = true;
+bool     modeBlending             = true;
+bool     useHarmonicRandomPalette = true;
+uint8_t  randomPaletteChangeTime  = 5;
+bool     useGlobalLedBuffer       = true;
+bool     useAMPM                  = false;
+bool     stateChanged             = false;
+byte     realtimeMode             = REALTIME_MODE_INACTIVE;
+byte     realtimeOverride         = REALTIME_OVERRIDE_NONE;
+bool     realtimeRespectLedMaps   = true;
+bool     useMainSegmentOnly       = false;
+byte     interfaceUpdateCallMode  = CALL_MODE_INIT;
+time_t   localTime                = 0;
+byte     errorFlag                = 0;
+uint8_t  currentLedmap            = 0;
+byte     overlayCurrent           = 0;
+String   escapedMac;
+char     serverDescription[33]    = "WLED";
+bool     correctPIN               = true;
+unsigned long lastEditTime        = 0;
+char     settingsPIN[5]           = "";
+uint32_t ledMaps                  = 0;
+char    *ledmapNames[WLED_MAX_LEDMAPS-1] = {nullptr};
+volatile uint8_t jsonBufferLock   = 0;
+uint32_t jsonLockRequests         = 0;
+uint32_t jsonLockContended        = 0;
+uint32_t jsonLockFailed           = 0;
+uint32_t jsonLockWaitTotal        = 0;
+uint32_t jsonLockWaitMax          = 0;
+uint32_t jsonPoolUsed             = 0;
+
+static DynamicJsonDocument gDoc(JSON_BUFFER_SIZE);
+JsonDocument *pDoc = &gDoc;
+
+WS2812FX strip;
+
+// ---- strip ----
+void nativeBegin(unsigned width, unsigned height) {
+  NeoGammaWLEDMethod::calcGammaTable(gammaCorrectVal); // done by deserializeConfig() on device
+  uint8_t pins[OUTPUT_MAX_PINS] = {0};
+  BusManager::removeAll();
+  BusConfig bc(TYPE_VIRTUAL_MEMORY, pins, 0, width * height);
+  BusManager::add(bc);
+  #ifndef WLED_DISABLE_2D
+  strip.isMatrix = height > 1;
+  strip.panel.clear();
+  if (strip.isMatrix) {
+    WS2812FX::Panel p;
+    p.width  = width;
+    p.height = height;
+    strip.panels = 1;
+    strip.panel.push_back(p);
+  }
+  #endif
+  strip.finalizeInit();
+  strip.makeAutoSegments(true);
+  strip.setBrightness(255, true);
+}
+
+// ---- stubs ----
+bool PinManager::isPinAllocated(byte gpio, PinOwner tag) { return false; }
+bool PinManager::isPinOk(byte gpio, bool output)         { return gpio < GPIO_PIN_COUNT; }
+
+void createEditHandler(bool enable) {}
+
+void serveJsonError(AsyncWebServerRequest* request, uint16_t code, uint16_t error) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "{\"error\":%u}", error);
+  request->send(code, CONTENT_TYPE_JSON, buf);
+}
+
+bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest) { return false; }
@@ -0,0 +1,205 @@
+#ifndef NATIVE_ARDUINO_H
+#define NATIVE_ARDUINO_H
+/*
+ * Minimal Arduino core replacement for host (native) builds of the effect engine
+ * Only what FX.cpp, FX_fcn.cpp, FX_2Dfcn.cpp, colors.cpp, wled_math.cpp and benchmark.cpp need.
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+#include <assert.h>
+#include <algorithm>
+#include <string>
+#include <type_traits>
+
+typedef uint8_t byte;
+typedef bool    boolean;
+
+using std::min;
+using std::max;
+
+// no flash/IRAM distinction on host
+#define PROGMEM
+#define PGM_P                 const char *
+#define IRAM_ATTR
+#define ICACHE_RAM_ATTR
+#define PSTR(s)               (s)
+#define F(s)                  (s)
+#define FPSTR(s)              ((const char *)(s))
+#define pgm_read_byte(a)      (*(const uint8_t *)(a))
+#define pgm_read_byte_near(a) pgm_read_byte(a)
+#define pgm_read_word(a)      (*(const uint16_t *)(a))
+#define pgm_read_dword(a)     native_read_dword(a)
+#define pgm_read_float(a)     (*(const float *)(a))
+#define pgm_read_ptr(a)       (*(const void * const *)(a))
+
+// on the MCU pointers are 32 bit and PROGMEM pointer tables are read with pgm_read_dword(), keep full pointer on 64 bit hosts
+template<typename T> inline typename std::enable_if<std::is_pointer<T>::value, typename std::remove_cv<T>::type>::type native_read_dword(const T *a) { return *a; }
+template<typename T> inline typename std::enable_if<!std::is_pointer<T>::value, uint32_t>::type native_read_dword(const T *a) { uint32_t v; memcpy(&v, a, sizeof(v)); return v; }
+#if !defined(__GLIBC__) || !__GLIBC_PREREQ(2, 38)
+inline size_t strlcpy(char *dst, const char *src, size_t size) {
+  size_t len = strlen(src);
+  if (size) { size_t n = len < size ? len : size - 1; memcpy(dst, src, n); dst[n] = 0; }
+  return len;
+}
+#endif
+#define strcpy_P              strcpy
+#define strncpy_P             strncpy
+#define strcat_P              strcat
+#define strlen_P              strlen
+#define strcmp_P              strcmp
+#define strncmp_P             strncmp
+#define strstr_P              strstr
+#define memcpy_P              memcpy
+#define sprintf_P             sprintf
+#define snprintf_P            snprintf
+
+#ifndef PI
+#define PI         3.1415926535897932384626433832795
+#endif
+#ifndef M_TWOPI
+#define M_TWOPI    6.283185307179586476925286766559
+#endif
+#define HALF_PI    1.5707963267948966192313216916398
+#define TWO_PI     6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define radians(deg)            ((deg)*DEG_TO_RAD)
+#define degrees(rad)            ((rad)*RAD_TO_DEG)
+#define sq(x)                   ((x)*(x))
+#define lowByte(w)              ((uint8_t) ((w) & 0xff))
+#define highByte(w)             ((uint8_t) ((w) >> 8))
+#define bitRead(value, bit)     (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit)      ((value) |= (1UL << (bit)))
+#define bitClear(value, bit)    ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  const long dividend = out_max - out_min;
+  const long divisor  = in_max - in_min;
+  if (divisor == 0) return -1; // same as Arduino core
+  return (x - in_min) * dividend / divisor + out_min;
+}
+
+// time: real monotonic clock plus an offset that tests/benchmarks may advance (see native.cpp)
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+void nativeAdvanceTime(unsigned long ms); // host only: moves millis()/micros() forward without sleeping
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+// minimal Print/String/IPAddress so WLED declarations using them compile
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buf, size_t len) { size_t n = 0; while (len--) n += write(*buf++); return n; }
+    size_t print(const char *s)           { return s ? write((const uint8_t *)s, strlen(s)) : 0; }
+    size_t print(char c)                  { return write((uint8_t)c); }
+    size_t print(int v)                   { return printf("%d", v); }
+    size_t print(unsigned v)              { return printf("%u", v); }
+    size_t print(long v)                  { return printf("%ld", v); }
+    size_t print(unsigned long v)         { return printf("%lu", v); }
+    size_t print(double v, int d = 2)     { return printf("%.*f", d, v); }
+    template<typename T> size_t println(T v) { size_t n = print(v); return n + print('\n'); }
+    size_t println()                      { return print('\n'); }
+    size_t printf(const char *fmt, ...) __attribute__ ((format (printf, 2, 3))) {
+      char buf[256];
+      va_list ap;
+      va_start(ap, fmt);
+      int n = vsnprintf(buf, sizeof(buf), fmt, ap);
+      va_end(ap);
+      if (n < 0) return 0;
+      if ((size_t)n >= sizeof(buf)) { // long output, format again into heap buffer
+        char *big = (char *)malloc(n + 1);
+        if (!big) return 0;
+        va_start(ap, fmt);
+        vsnprintf(big, n + 1, fmt, ap);
+        va_end(ap);
+        size_t w = write((const uint8_t *)big, n);
+        free(big);
+        return w;
+      }
+      return write((const uint8_t *)buf, n);
+    }
+};
+#define printf_P printf
+
+class HardwareSerial : public Print {
+  public:
+    void begin(unsigned long) {}
+    size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+    size_t write(const uint8_t *buf, size_t len) override { return fwrite(buf, 1, len, stdout); }
+    operator bool() const { return true; }
+};
+extern HardwareSerial Serial;
+
+class String {
+  public:
+    String(const char *s = "") : _s(s ? s : "") {}
+    String(const std::string &s) : _s(s) {}
+    String(char c) : _s(1, c) {}
+    String(int v)           : _s(std::to_string(v)) {}
+    String(unsigned v)      : _s(std::to_string(v)) {}
+    String(long v)          : _s(std::to_string(v)) {}
+    String(unsigned long v) : _s(std::to_string(v)) {}
+    const char *c_str() const    { return _s.c_str(); }
+    unsigned    length() const   { return _s.length(); }
+    long        toInt() const    { return strtol(_s.c_str(), nullptr, 10); }
+    float       toFloat() const  { return strtof(_s.c_str(), nullptr); }
+    bool        isEmpty() const  { return _s.empty(); }
+    char operator[](unsigned i) const { return i < _s.length() ? _s[i] : 0; }
+    char charAt(unsigned i) const     { return (*this)[i]; }
+    int  indexOf(char c, unsigned from = 0) const        { size_t p = _s.find(c, from); return p == std::string::npos ? -1 : (int)p; }
+    int  indexOf(const char *s, unsigned from = 0) const { size_t p = _s.find(s, from); return p == std::string::npos ? -1 : (int)p; }
+    int  lastIndexOf(char c) const                       { size_t p = _s.rfind(c);      return p == std::string::npos ? -1 : (int)p; }
+    String substring(unsigned from) const { return from < _s.length() ? String(_s.substr(from)) : String(); }
+    String substring(unsigned from, unsigned to) const {
+      if (from > to) std::swap(from, to);
+      if (from >= _s.length()) return String();
+      return String(_s.substr(from, std::min<size_t>(to, _s.length()) - from));
+    }
+    String &operator+=(const String &o) { _s += o._s; return *this; }
+    String &operator+=(const char *o)   { _s += o ? o : ""; return *this; }
+    String &operator+=(char c)          { _s += c; return *this; }
+    bool operator==(const String &o) const { return _s == o._s; }
+    bool operator==(const char *o) const   { return o && _s == o; }
+    bool operator!=(const String &o) const { return _s != o._s; }
+    friend String operator+(String a, const String &b) { a += b; return a; }
+  private:
+    std::string _s;
+};
+
+class IPAddress {
+  public:
+    IPAddress(uint32_t a = 0) { memcpy(_b, &a, 4); }
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _b{a, b, c, d} {}
+    operator uint32_t() const { uint32_t a; memcpy(&a, _b, 4); return a; }
+    uint8_t  operator[](int i) const { return _b[i]; }
+    uint8_t &operator[](int i)       { return _b[i]; }
+    bool operator==(const IPAddress &o) const { return memcmp(_b, o._b, 4) == 0; }
+  private:
+    uint8_t _b[4];
+};
+
+// heap statistics used by the effect engine
+class EspClass {
+  public:
+    uint32_t getFreeHeap()     { return 256 * 1024; }
+    uint32_t getMaxAllocHeap() { return 128 * 1024; }
+};
+extern EspClass ESP;
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef NATIVE_ESPASYNCWEBSERVER_H
+#define NATIVE_ESPASYNCWEBSERVER_H
+/*
+ * Web server stand-in for host builds
+ * Requests carry query parameters only; response streams are written to stdout (or a FILE) so that
+ * request handlers like serveBenchmark() can be called from a host program.
+ */
+#include <Arduino.h>
+#include <vector>
+
+#define CONTENT_TYPE_JSON  "application/json"
+#define CONTENT_TYPE_PLAIN "text/plain"
+
+class AsyncWebParameter {
+  public:
+    AsyncWebParameter(const String &name, const String &value) : _name(name), _value(value) {}
+    const String &name() const  { return _name; }
+    const String &value() const { return _value; }
+  private:
+    String _name;
+    String _value;
+};
+
+class AsyncWebServerResponse {
+  public:
+    virtual ~AsyncWebServerResponse() {}
+    void addHeader(const String &, const String &) {}
+    int code() const { return _code; }
+  protected:
+    int _code = 200;
+};
+
+class AsyncResponseStream : public AsyncWebServerResponse, public Print {
+  public:
+    explicit AsyncResponseStream(FILE *out) : _out(out) {}
+    size_t write(uint8_t c) override { return fputc(c, _out) == EOF ? 0 : 1; }
+    size_t write(const uint8_t *buf, size_t len) override { return fwrite(buf, 1, len, _out); }
+  private:
+    FILE *_out;
+};
+
+class AsyncWebServerRequest {
+  public:
+    explicit AsyncWebServerRequest(FILE *out = stdout) : _out(out) {}
+    ~AsyncWebServerRequest() { for (auto p : _params) delete p; }
+    void addParam(const String &name, const String &value = "") { _params.push_back(new AsyncWebParameter(name, value)); }
+    bool hasParam(const String &name) const { return getParam(name) != nullptr; }
+    AsyncWebParameter *getParam(const String &name) const {
+      for (auto p : _params) if (p->name() == name) return p;
+      return nullptr;
+    }
+    AsyncResponseStream *beginResponseStream(const String &, size_t = 0) { return new AsyncResponseStream(_out); }
+    void send(AsyncWebServerResponse *response) { _code = response->code(); delete response; }
+    void send(int code, const String & = "", const String &content = "") { _code = code; fputs(content.c_str(), _out); }
+    int code() const { return _code; }
+  private:
+    FILE *_out;
+    int _code = 0;
+    std::vector<AsyncWebParameter *> _params;
+};
+
+class AsyncWebSocket;
+class AsyncWebSocketClient;
+typedef enum { WS_EVT_CONNECT, WS_EVT_DISCONNECT, WS_EVT_PONG, WS_EVT_ERROR, WS_EVT_DATA } AwsEventType;
+
+#endif
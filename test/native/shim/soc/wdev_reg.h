@@ -0,0 +1,12 @@
+#ifndef NATIVE_WDEV_REG_H
+#define NATIVE_WDEV_REG_H
+/*
+ * Hardware random number register replacement for host builds (used by hw_random() in fcn_declare.h)
+ */
+#include <stdint.h>
+
+uint32_t nativeRandom32();
+#define WDEV_RND_REG 0
+#define REG_READ(reg) nativeRandom32()
+
+#endif
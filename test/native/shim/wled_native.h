@@ -0,0 +1,92 @@
+#ifndef WLED_NATIVE_H
+#define WLED_NATIVE_H
+/*
+ * Host (native) replacement for wled.h, force-included before every translation unit of the native build.
+ * Defines WLED_H so the firmware header (WiFi, file system, web server...) is skipped and provides only
+ * what the effect engine needs: FastLED, WLED declarations, and the globals it reads (defined in native.cpp).
+ */
+#define WLED_H
+#define ASYNC_JSON_H_ // AsyncJson-v6.h needs the real web server
+#define ARDUINOJSON_ENABLE_PROGMEM 0
+#define ARDUINOJSON_ENABLE_ARDUINO_STRING 0
+#define ARDUINOJSON_ENABLE_ARDUINO_STREAM 0
+#define ARDUINOJSON_ENABLE_ARDUINO_PRINT 0
+
+#include <Arduino.h>
+#include "FastLED.h"
+#include "ESPAsyncWebServer.h"
+#include "src/dependencies/json/ArduinoJson-v6.h"
+#include "src/dependencies/time/TimeLib.h"
+
+// network/system types only appear in declarations of fcn_declare.h
+struct e131_packet_t;
+struct ArtPollReply;
+class  AsyncClient;
+typedef int WiFiEvent_t;
+#define GPIO_PIN_COUNT 50
+#include "const.h"
+#include "fcn_declare.h"
+#include "bus_manager.h"
+#include "perf.h"
+#include "FX.h"
+
+#define DEBUG_PRINT(x)
+#define DEBUG_PRINTLN(x)
+#define DEBUG_PRINTF(x...)
+#define DEBUG_PRINTF_P(x...)
+
+#define RGBW32(r,g,b,w) (uint32_t((byte(w) << 24) | (byte(r) << 16) | (byte(g) << 8) | (byte(b))))
+#define R(c) (byte((c) >> 16))
+#define G(c) (byte((c) >> 8))
+#define B(c) (byte(c))
+#define W(c) (byte((c) >> 24))
+
+// globals of wled.h read by the effect engine, defined in native.cpp
+extern bool     gammaCorrectCol;
+extern bool     gammaCorrectBri;
+extern float    gammaCorrectVal;
+extern byte     lastRandomIndex;
+extern bool     fadeTransition;
+extern bool     modeBlending;
+extern bool     useHarmonicRandomPalette;
+extern uint8_t  randomPaletteChangeTime;
+extern bool     useGlobalLedBuffer;
+extern bool     useAMPM;
+extern bool     stateChanged;
+extern byte     realtimeOverride;
+extern bool     useMainSegmentOnly;
+extern byte     interfaceUpdateCallMode;
+extern time_t   localTime;
+extern byte     errorFlag;
+extern uint8_t  currentLedmap;
+extern byte     overlayCurrent;
+extern JsonDocument *pDoc;
+extern String   escapedMac;
+extern char     serverDescription[33];
+extern bool     correctPIN;
+extern unsigned long lastEditTime;
+extern char     settingsPIN[5];
+extern uint32_t ledMaps;
+extern char    *ledmapNames[WLED_MAX_LEDMAPS-1];
+extern volatile uint8_t jsonBufferLock;
+extern uint32_t jsonLockRequests;
+extern uint32_t jsonLockContended;
+extern uint32_t jsonLockFailed;
+extern uint32_t jsonLockWaitTotal;
+extern uint32_t jsonLockWaitMax;
+extern uint32_t jsonPoolUsed;
+#define PSRAMDynamicJsonDocument DynamicJsonDocument
+extern WS2812FX strip;
+
+// no file system on host: ledmaps, gap tables and custom palettes are never found
+class NativeFS {
+  public:
+    bool exists(const char *) { return false; }
+};
+extern NativeFS nativeFS;
+#define WLED_FS nativeFS
+
+// host only: creates a memory bus with given number of LEDs (as a matrix if height > 1) and initializes strip
+void nativeBegin(unsigned width, unsigned height = 1);
+
+#endif
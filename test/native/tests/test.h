@@ -0,0 +1,44 @@
+#ifndef WLED_NATIVE_TEST_H
+#define WLED_NATIVE_TEST_H
+/*
+ * Minimal helpers for host tests: failed checks are printed and counted, test exits with failure count
+ */
+#include <stdio.h>
+
+static unsigned testChecks   = 0;
+static unsigned testFailures = 0;
+
+#define TEST_CHECK(cond, ...) do { \
+  testChecks++; \
+  if (!(cond)) { \
+    if (++testFailures <= 20) { printf("%s:%d: ", __FILE__, __LINE__); printf(__VA_ARGS__); putchar('\n'); } \
+  } \
+} while (0)
+
+static inline int testResult(const char *name) {
+  printf("%s: %u checks, %u failed\n", name, testChecks, testFailures);
+  return testFailures ? 1 : 0;
+}
+
+// repeatable pseudo random numbers (xorshift32)
+static uint32_t testRandomState = 0x12345678;
+static inline uint32_t testRandom() {
+  testRandomState ^= testRandomState << 13;
+  testRandomState ^= testRandomState >> 17;
+  testRandomState ^= testRandomState << 5;
+  return testRandomState;
+}
+static inline uint32_t testRandom(uint32_t limit) { return limit ? testRandom() % limit : 0; }
+
+// random pixel color: black, pure RGB or any RGBW value
+static inline uint32_t testRandomColor() {
+  const uint32_t c = testRandom();
+  switch (testRandom(5)) {
+    case 0:  return 0;
+    case 1:  return c & 0x00FFFFFF;
+    case 2:  return c & 0x00FF00FF;
+    default: return c;
+  }
+}
+
+#endif
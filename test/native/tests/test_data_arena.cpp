@@ -0,0 +1,51 @@
+/*
+ * Effect data arena (FX_fcn.cpp): allocation that fits the budget but not any hole compacts the arena
+ * and succeeds in the same frame, data of other segments is moved with it
+ */
+#include "test.h"
+
+static void fillData(Segment &seg, uint8_t value) { memset(seg.data, value, seg.dataSize()); }
+
+static bool checkData(const Segment &seg, uint8_t value) {
+  for (unsigned i = 0; i < seg.dataSize(); i++) if (seg.data[i] != value) return false;
+  return true;
+}
+
+static void testCompactOnAllocate() {
+  const unsigned quarter = MAX_SEGMENT_DATA / 4;
+  strip.appendSegment(Segment(0, 100));
+  strip.appendSegment(Segment(100, 200));
+  TEST_CHECK(strip.getSegmentsNum() >= 3, "3 segments (%u)", strip.getSegmentsNum());
+  Segment &a = strip.getSegment(0);
+  Segment &b = strip.getSegment(1);
+  Segment &c = strip.getSegment(2);
+  for (Segment *seg : {&a, &b, &c}) seg->deallocateData();
+
+  TEST_CHECK(a.allocateData(quarter) && b.allocateData(quarter) && c.allocateData(quarter), "3 quarters fit");
+  fillData(b, 0xB0);
+  fillData(c, 0xC0);
+  const byte *oldB = b.data;
+  const unsigned moves = Segment::getSegmentDataMoves();
+
+  // hole at the bottom and space at the top are both smaller than a third, together they are not
+  a.deallocateData();
+  a.call = 1; // effect is running, init in a later frame would be skipped
+  TEST_CHECK(a.allocateData(MAX_SEGMENT_DATA / 3), "allocation within budget succeeds in fragmented arena");
+  TEST_CHECK(Segment::getSegmentDataMoves() == moves + 1, "arena was compacted");
+  TEST_CHECK(b.data != oldB, "data of other segment was moved");
+  TEST_CHECK(checkData(b, 0xB0) && checkData(c, 0xC0), "data of other segments is unchanged");
+  TEST_CHECK(a.data && checkData(a, 0), "new data is cleared");
+  TEST_CHECK(Segment::getSegmentDataFragmentation() == 0, "no holes left");
+
+  // over budget still fails
+  b.deallocateData();
+  TEST_CHECK(!b.allocateData(MAX_SEGMENT_DATA), "allocation over budget fails");
+  for (Segment *seg : {&a, &b, &c}) seg->deallocateData();
+  TEST_CHECK(Segment::getUsedSegmentData() == 0, "all data released (%u)", Segment::getUsedSegmentData());
+}
+
+int main() {
+  nativeBegin(300);
+  testCompactOnAllocate();
+  return testResult("effect data arena");
+}
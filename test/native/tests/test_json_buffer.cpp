@@ -0,0 +1,59 @@
+/*
+ * JSON response documents (util.cpp): without PSRAM a response is serialized into the global buffer and
+ * detached into a copy sized to its content, global buffer lock is released while the copy is sent
+ */
+#include <string>
+#include "test.h"
+
+static void fillResponse(JsonDocument *doc, unsigned entries) {
+  JsonObject root = doc->to<JsonObject>();
+  JsonObject state = root.createNestedObject("state");
+  state["on"] = true;
+  state["bri"] = 128;
+  JsonArray arr = root.createNestedArray("list");
+  for (unsigned i = 0; i < entries; i++) arr.add(std::string("entry ") + std::to_string(i)); // copied strings
+}
+
+static void testDetach() {
+  for (unsigned entries : {0u, 1u, 10u, 200u}) {
+    const uint32_t used = jsonPoolUsed;
+    JsonDocument *doc = requestJSONBuffer(17);
+    TEST_CHECK(doc == pDoc, "without PSRAM response is serialized into global buffer");
+    TEST_CHECK(jsonBufferLock == 17, "lock is held while serializing (%u)", jsonBufferLock);
+    fillResponse(doc, entries);
+    std::string expected;
+    serializeJson(*doc, expected);
+
+    doc = detachJSONBuffer(doc);
+    TEST_CHECK(doc && doc != pDoc, "%u entries: detached response is a copy", entries);
+    TEST_CHECK(jsonBufferLock == 0, "%u entries: lock is released when detached (%u)", entries, jsonBufferLock);
+    TEST_CHECK(jsonPoolUsed == used + 1, "%u entries: detached response is counted", entries);
+    TEST_CHECK(doc->capacity() < pDoc->capacity(), "%u entries: copy is sized to content (%u)", entries, (unsigned)doc->capacity());
+
+    // global buffer may be used by others while response is sent
+    TEST_CHECK(requestJSONBufferLock(7), "%u entries: global buffer can be locked while response is sent", entries);
+    pDoc->to<JsonObject>()["other"] = "content";
+    std::string sent;
+    serializeJson(*doc, sent);
+    TEST_CHECK(sent == expected, "%u entries: sent %s, expected %s", entries, sent.c_str(), expected.c_str());
+    releaseJSONBufferLock();
+
+    releaseJSONBuffer(doc); // copy is freed (leak is reported by ASan builds)
+    TEST_CHECK(jsonBufferLock == 0, "%u entries: release of copy does not touch lock", entries);
+  }
+}
+
+static void testReleaseUndetached() {
+  JsonDocument *doc = requestJSONBuffer(17);
+  TEST_CHECK(doc == pDoc, "response is serialized into global buffer");
+  releaseJSONBuffer(doc); // response was never detached (e.g. not sent)
+  TEST_CHECK(jsonBufferLock == 0, "lock is released with global buffer (%u)", jsonBufferLock);
+  TEST_CHECK(requestJSONBuffer(17) == pDoc, "global buffer can be requested again");
+  releaseJSONBuffer(pDoc);
+}
+
+int main() {
+  testDetach();
+  testReleaseUndetached();
+  return testResult("JSON buffer");
+}
@@ -0,0 +1,280 @@
+/*
+ * Span kernels (colors.cpp) must give the same result as the per-pixel code they replaced in
+ * Segment::fade_out(), fadeToBlackBy(), blur(), blur2D(), moveX() and moveY(); box blur is checked against a plain average
+ */
+#include <vector>
+#include "test.h"
+
+// pixel buffer with the get/set access the old per-pixel code used
+struct RefBuffer {
+  int w, h;
+  std::vector<uint32_t> px;
+  RefBuffer(int width, int height) : w(width), h(height), px(width * height) {}
+  uint32_t getPixelColorXY(int x, int y) const { return (unsigned)x < (unsigned)w && (unsigned)y < (unsigned)h ? px[x + y * w] : 0; }
+  void setPixelColorXY(int x, int y, uint32_t c) { if ((unsigned)x < (unsigned)w && (unsigned)y < (unsigned)h) px[x + y * w] = c; }
+};
+
+// ---- reference implementations (per-pixel code before span kernels) ----
+
+static void refFadeOut(RefBuffer &s, uint8_t rate, uint32_t target) {
+  rate = (255-rate) >> 1;
+  float mappedRate = 1.0f / (float(rate) + 1.1f);
+  int w2 = W(target);
+  int r2 = R(target);
+  int g2 = G(target);
+  int b2 = B(target);
+  for (int y = 0; y < s.h; y++) for (int x = 0; x < s.w; x++) {
+    uint32_t color = s.getPixelColorXY(x, y);
+    if (color == target) continue;
+    int w1 = W(color);
+    int r1 = R(color);
+    int g1 = G(color);
+    int b1 = B(color);
+    int wdelta = (w2 - w1) * mappedRate;
+    int rdelta = (r2 - r1) * mappedRate;
+    int gdelta = (g2 - g1) * mappedRate;
+    int bdelta = (b2 - b1) * mappedRate;
+    wdelta += (w2 == w1) ? 0 : (w2 > w1) ? 1 : -1;
+    rdelta += (r2 == r1) ? 0 : (r2 > r1) ? 1 : -1;
+    gdelta += (g2 == g1) ? 0 : (g2 > g1) ? 1 : -1;
+    bdelta += (b2 == b1) ? 0 : (b2 > b1) ? 1 : -1;
+    s.setPixelColorXY(x, y, RGBW32(r1 + rdelta, g1 + gdelta, b1 + bdelta, w1 + wdelta));
+  }
+}
+
+static void refFadeToBlackBy(RefBuffer &s, uint8_t fadeBy) {
+  if (fadeBy == 0) return;
+  for (int y = 0; y < s.h; y++) for (int x = 0; x < s.w; x++) s.setPixelColorXY(x, y, color_fade(s.getPixelColorXY(x, y), 255-fadeBy));
+}
+
+// blur2D(); with blur_y = 0 on a single row this is also the old 1D blur()
+static void refBlur2D(RefBuffer &s, uint8_t blur_x, uint8_t blur_y, bool smear) {
+  const unsigned cols = s.w;
+  const unsigned rows = s.h;
+  uint32_t lastnew = BLACK;
+  uint32_t last = BLACK;
+  if (blur_x) {
+    const uint8_t keepx = smear ? 255 : 255 - blur_x;
+    const uint8_t seepx = blur_x >> 1;
+    for (unsigned row = 0; row < rows; row++) {
+      uint32_t carryover = BLACK;
+      uint32_t curnew = BLACK;
+      for (unsigned x = 0; x < cols; x++) {
+        uint32_t cur = s.getPixelColorXY(x, row);
+        uint32_t part = color_fade(cur, seepx);
+        curnew = color_fade(cur, keepx);
+        if (x > 0) {
+          if (carryover) curnew = color_add(curnew, carryover);
+          uint32_t prev = color_add(lastnew, part);
+          if (last != prev) s.setPixelColorXY(x - 1, row, prev);
+        } else s.setPixelColorXY(x, row, curnew);
+        lastnew = curnew;
+        last = cur;
+        carryover = part;
+      }
+      s.setPixelColorXY(cols-1, row, curnew);
+    }
+  }
+  if (blur_y) {
+    const uint8_t keepy = smear ? 255 : 255 - blur_y;
+    const uint8_t seepy = blur_y >> 1;
+    for (unsigned col = 0; col < cols; col++) {
+      uint32_t carryover = BLACK;
+      uint32_t curnew = BLACK;
+      for (unsigned y = 0; y < rows; y++) {
+        uint32_t cur = s.getPixelColorXY(col, y);
+        uint32_t part = color_fade(cur, seepy);
+        curnew = color_fade(cur, keepy);
+        if (y > 0) {
+          if (carryover) curnew = color_add(curnew, carryover);
+          uint32_t prev = color_add(lastnew, part);
+          if (last != prev) s.setPixelColorXY(col, y - 1, prev);
+        } else s.setPixelColorXY(col, y, curnew);
+        lastnew = curnew;
+        last = cur;
+        carryover = part;
+      }
+      s.setPixelColorXY(col, rows - 1, curnew);
+    }
+  }
+}
+
+static void refMoveX(RefBuffer &s, int delta, bool wrap) {
+  const int vW = s.w, vH = s.h;
+  if (!delta) return;
+  int absDelta = abs(delta);
+  if (absDelta >= vW) return;
+  std::vector<uint32_t> newPxCol(vW);
+  int newDelta;
+  int stop = vW;
+  int start = 0;
+  if (wrap) newDelta = (delta + vW) % vW;
+  else {
+    if (delta < 0) start = absDelta;
+    stop = vW - absDelta;
+    newDelta = delta > 0 ? delta : 0;
+  }
+  for (int y = 0; y < vH; y++) {
+    for (int x = 0; x < stop; x++) {
+      int srcX = x + newDelta;
+      if (wrap) srcX %= vW;
+      newPxCol[x] = s.getPixelColorXY(srcX, y);
+    }
+    for (int x = 0; x < stop; x++) s.setPixelColorXY(x + start, y, newPxCol[x]);
+  }
+}
+
+static void refMoveY(RefBuffer &s, int delta, bool wrap) {
+  const int vW = s.w, vH = s.h;
+  if (!delta) return;
+  int absDelta = abs(delta);
+  if (absDelta >= vH) return;
+  std::vector<uint32_t> newPxCol(vH);
+  int newDelta;
+  int stop = vH;
+  int start = 0;
+  if (wrap) newDelta = (delta + vH) % vH;
+  else {
+    if (delta < 0) start = absDelta;
+    stop = vH - absDelta;
+    newDelta = delta > 0 ? delta : 0;
+  }
+  for (int x = 0; x < vW; x++) {
+    for (int y = 0; y < stop; y++) {
+      int srcY = y + newDelta;
+      if (wrap) srcY %= vH;
+      newPxCol[y] = s.getPixelColorXY(x, srcY);
+    }
+    for (int y = 0; y < stop; y++) s.setPixelColorXY(x, y + start, newPxCol[y]);
+  }
+}
+
+// Segment::box_blur(): each channel is the average of the window clipped at the edges (rounded down), rows then columns
+static void refBoxBlur(RefBuffer &s, unsigned rx, unsigned ry) {
+  for (int dir = 0; dir < 2; dir++) {
+    const int r = dir ? ry : rx;
+    if (!r) continue;
+    RefBuffer src = s;
+    for (int y = 0; y < s.h; y++) for (int x = 0; x < s.w; x++) {
+      unsigned sum[4] = {0}, count = 0;
+      for (int d = -r; d <= r; d++) {
+        const int sx = dir ? x : x + d;
+        const int sy = dir ? y + d : y;
+        if (sx < 0 || sx >= s.w || sy < 0 || sy >= s.h) continue;
+        const uint32_t c = src.getPixelColorXY(sx, sy);
+        sum[0] += R(c); sum[1] += G(c); sum[2] += B(c); sum[3] += W(c);
+        count++;
+      }
+      s.setPixelColorXY(x, y, RGBW32(sum[0]/count, sum[1]/count, sum[2]/count, sum[3]/count));
+    }
+  }
+}
+
+// ---- tests ----
+
+#define RUNS 2000
+
+static RefBuffer randomBuffer(int maxW, int maxH) {
+  RefBuffer s(1 + testRandom(maxW), 1 + testRandom(maxH));
+  for (auto &c : s.px) c = testRandomColor();
+  return s;
+}
+
+static int firstDifference(const RefBuffer &a, const std::vector<uint32_t> &b) {
+  for (size_t i = 0; i < a.px.size(); i++) if (a.px[i] != b[i]) return i;
+  return -1;
+}
+
+static void testFadeToward() {
+  for (unsigned run = 0; run < RUNS; run++) {
+    RefBuffer ref = randomBuffer(64, 16);
+    std::vector<uint32_t> px = ref.px;
+    const uint8_t  rate   = testRandom(256);
+    const uint32_t target = testRandomColor();
+    refFadeOut(ref, rate, target);
+    color_fade_toward_span(px.data(), px.size(), target, rate);
+    const int d = firstDifference(ref, px);
+    TEST_CHECK(d < 0, "color_fade_toward_span: %dx%d rate %u target %08X: pixel %d is %08X, expected %08X",
+               ref.w, ref.h, rate, target, d, d < 0 ? 0 : px[d], d < 0 ? 0 : ref.px[d]);
+  }
+}
+
+static void testFade() {
+  for (unsigned run = 0; run < RUNS; run++) {
+    RefBuffer ref = randomBuffer(64, 16);
+    std::vector<uint32_t> px = ref.px;
+    const uint8_t fadeBy = run < 256 ? run : testRandom(256); // all amounts at least once
+    refFadeToBlackBy(ref, fadeBy);
+    if (fadeBy) color_fade_span(px.data(), px.size(), 255-fadeBy);
+    const int d = firstDifference(ref, px);
+    TEST_CHECK(d < 0, "color_fade_span: %dx%d fade %u: pixel %d is %08X, expected %08X",
+               ref.w, ref.h, fadeBy, d, d < 0 ? 0 : px[d], d < 0 ? 0 : ref.px[d]);
+  }
+}
+
+static void testBlur() {
+  for (unsigned run = 0; run < RUNS; run++) {
+    const bool is2D = run & 1;
+    RefBuffer ref = randomBuffer(64, is2D ? 16 : 1);
+    std::vector<uint32_t> px = ref.px;
+    const uint8_t blur_x = testRandom(256);
+    const uint8_t blur_y = is2D ? testRandom(256) : 0;
+    const bool    smear  = testRandom(2);
+    refBlur2D(ref, blur_x, blur_y, smear);
+    // same calls as Segment::blur2D()
+    if (blur_x) for (int row = 0; row < ref.h; row++) color_blur_span(px.data() + row * ref.w, ref.w, 1, smear ? 255 : 255 - blur_x, blur_x >> 1);
+    if (blur_y) for (int col = 0; col < ref.w; col++) color_blur_span(px.data() + col, ref.h, ref.w, smear ? 255 : 255 - blur_y, blur_y >> 1);
+    const int d = firstDifference(ref, px);
+    TEST_CHECK(d < 0, "color_blur_span: %dx%d blur %u,%u%s: pixel %d is %08X, expected %08X",
+               ref.w, ref.h, blur_x, blur_y, smear ? " smear" : "", d, d < 0 ? 0 : px[d], d < 0 ? 0 : ref.px[d]);
+  }
+}
+
+static void testBoxBlur() {
+  for (unsigned run = 0; run < RUNS; run++) {
+    RefBuffer ref = randomBuffer(64, 24);
+    std::vector<uint32_t> px = ref.px;
+    std::vector<uint32_t> tmp(std::max(ref.w, ref.h));
+    const unsigned rx = testRandom(BOX_BLUR_MAX_RADIUS + 1);
+    const unsigned ry = testRandom(BOX_BLUR_MAX_RADIUS + 1);
+    refBoxBlur(ref, rx, ry);
+    // same calls as Segment::box_blur() (one pass)
+    if (rx) for (int row = 0; row < ref.h; row++) color_box_blur_span(px.data() + row * ref.w, ref.w, 1, rx, tmp.data());
+    if (ry) for (int col = 0; col < ref.w; col++) color_box_blur_span(px.data() + col, ref.h, ref.w, ry, tmp.data());
+    const int d = firstDifference(ref, px);
+    TEST_CHECK(d < 0, "color_box_blur_span: %dx%d radius %u,%u: pixel %d is %08X, expected %08X",
+               ref.w, ref.h, rx, ry, d, d < 0 ? 0 : px[d], d < 0 ? 0 : ref.px[d]);
+  }
+}
+
+static void testShift() {
+  for (unsigned run = 0; run < RUNS; run++) {
+    RefBuffer ref = randomBuffer(48, 16);
+    std::vector<uint32_t> px = ref.px;
+    const bool wrap = testRandom(2);
+    if (run & 1) { // moveX(): each row
+      const int delta = (int)testRandom(2 * ref.w + 1) - ref.w;
+      refMoveX(ref, delta, wrap);
+      if (abs(delta) < ref.w) for (int y = 0; y < ref.h; y++) color_shift_span(px.data() + y * ref.w, ref.w, delta, wrap);
+      const int d = firstDifference(ref, px);
+      TEST_CHECK(d < 0, "color_shift_span (x): %dx%d delta %d%s: pixel %d is %08X, expected %08X",
+                 ref.w, ref.h, delta, wrap ? " wrap" : "", d, d < 0 ? 0 : px[d], d < 0 ? 0 : ref.px[d]);
+    } else { // moveY(): whole buffer by rows
+      const int delta = (int)testRandom(2 * ref.h + 1) - ref.h;
+      refMoveY(ref, delta, wrap);
+      if (abs(delta) < ref.h) color_shift_span(px.data(), ref.w * ref.h, delta * ref.w, wrap);
+      const int d = firstDifference(ref, px);
+      TEST_CHECK(d < 0, "color_shift_span (y): %dx%d delta %d%s: pixel %d is %08X, expected %08X",
+                 ref.w, ref.h, delta, wrap ? " wrap" : "", d, d < 0 ? 0 : px[d], d < 0 ? 0 : ref.px[d]);
+    }
+  }
+}
+
+int main() {
+  testFadeToward();
+  testFade();
+  testBlur();
+  testBoxBlur();
+  testShift();
+  return testResult("span kernels");
+}
@@ -101,6 +101,12 @@ int8_t tristate_square8(uint8_t x, uint8_t pulsewidth, uint8_t attdec) {
   return 0;
 }
 
+// box_blur() radius (1-8) for strong blur() amounts, 0 if blur() should be used
+// radius 1 box blur spreads about as much as blur(170), weaker amounts cannot be done with a box blur
+static inline unsigned blurRadius(uint8_t amount) {
+  return amount >= 170 ? map(amount, 170, 255, 1, BOX_BLUR_MAX_RADIUS) : 0;
+}
+
 static um_data_t* getAudioData() {
   um_data_t *um_data;
   if (!UsermodManager::getUMData(&um_data, USERMOD_ID_AUDIOREACTIVE)) {
@@ -6854,7 +6860,9 @@ uint16_t mode_blurz(void) {                    // Blurz. By Andrew Tuline.
     ++(SEGENV.aux0) %= 16; // make sure it doesn't cross 16
 
     SEGENV.step = 1;
-    SEGMENT.blur(SEGMENT.intensity); // note: blur > 210 results in a alternating pattern, this could be fixed by mapping but some may like it (very old bug)
+    const unsigned radius = SEGMENT.is2D() ? blurRadius(SEGMENT.intensity) : 0;
+    if (radius) SEGMENT.box_blur(radius, radius);
+    else SEGMENT.blur(SEGMENT.intensity); // note: blur > 210 results in a alternating pattern, this could be fixed by mapping but some may like it (very old bug)
   }
 
   return FRAMETIME;
@@ -57,6 +57,7 @@ extern byte realtimeMode;           // used in getMappedPixelIndex()
 #else
   #define MIN_FRAME_DELAY  8                                              // 8266 legacy MIN_SHOW_DELAY
 #endif
+#define FRAME_KEEPALIVE  1000                                           // ms, frame is shown at least this often if all segments are frozen or unchanged (usermod overlays, current estimate)
 #define FPS_UNLIMITED    0
 
 // FPS calculation (can be defined as compile flag for debugging)
@@ -333,6 +334,14 @@ typedef enum mapping1D2D {
   M12_sPinwheel = 4
 } mapping1D2D_t;
 
+// segment blending modes (used when compositing segment layers onto the strip)
+typedef enum segBlendMode {
+  SEG_BLEND_NORMAL = 0,   // alpha blend using segment opacity
+  SEG_BLEND_ADD = 1,      // add to underlying pixels (saturating)
+  SEG_BLEND_MULTIPLY = 2, // multiply with underlying pixels
+  SEG_BLEND_MAX = 3       // keep brighter of each channel (lighten)
+} blendMode_t;
+
 // segment, 80 bytes
 typedef struct Segment {
   public:
@@ -373,7 +382,8 @@ typedef struct Segment {
     };
     uint8_t startY;  // start Y coodrinate 2D (top); there should be no more than 255 rows
     uint8_t stopY;   // stop Y coordinate 2D (bottom); there should be no more than 255 rows
-    // note: two bytes of padding are added here
+    uint8_t blendMode; // blending mode used when compositing segment onto underlying segments (see blendMode_t)
+    // note: one byte of padding is added here
     char    *name;
 
     // runtime data
@@ -384,6 +394,7 @@ typedef struct Segment {
     uint16_t aux1;  // custom var
     byte     *data; // effect data pointer
     static uint16_t maxWidth, maxHeight;  // these define matrix width & height (max. segment dimensions)
+    static bool usePaletteLUT;            // use 256 color lookup table for palette colors on long segments (can be disabled for benchmarking)
 
     typedef struct TemporarySegmentData {
       uint16_t _optionsT;
@@ -403,9 +414,13 @@ typedef struct Segment {
       uint32_t _callT;
       uint8_t *_dataT;
       unsigned _dataLenT;
+      uint32_t *_pixelsT;   // pixel buffer (layer) of the effect
+      unsigned _pixelsLenT;
       TemporarySegmentData()
         : _dataT(nullptr) // just in case...
         , _dataLenT(0)
+        , _pixelsT(nullptr)
+        , _pixelsLenT(0)
       {}
     } tmpsegd_t;
 
@@ -422,13 +437,17 @@ typedef struct Segment {
     };
     uint8_t         _default_palette;  // palette number that gets assigned to pal0
     unsigned        _dataLen;
+    uint32_t       *_pixels;                  // virtual pixel buffer (vWidth*vHeight, colors without opacity applied)
+    unsigned        _pixelsLen;               // number of allocated virtual pixels
     static unsigned _usedSegmentData;
     static uint8_t  _segBri;                  // brightness of segment for current effect
     static unsigned _vLength;                 // 1D dimension used for current effect
     static unsigned _vWidth, _vHeight;        // 2D dimensions used for current effect
     static uint32_t _currentColors[NUM_COLORS]; // colors used for current effect
-    static bool     _colorScaled;             // color has been scaled prior to setPixelColor() call
     static CRGBPalette16 _currentPalette;     // palette used for current effect (includes transition, used in color_from_palette())
+    static uint32_t _paletteLUT[256];         // _currentPalette expanded to 256 colors (full brightness), built on first use in a frame
+    static bool     _paletteLUTValid;         // _paletteLUT matches _currentPalette and paletteBlend
+    static uint32_t _paletteStep;             // 255/(_vLength-1) as 8.24 fixed point (replaces divide in color_from_palette()), 0 if not exact
     static CRGBPalette16 _randomPalette;      // actual random palette
     static CRGBPalette16 _newRandomPalette;   // target random palette
     static uint16_t _lastPaletteChange;       // last random palette change time in millis()/1000
@@ -460,7 +479,9 @@ typedef struct Segment {
       {}
     } *_t;
 
-    [[gnu::hot]] void _setPixelColorXY_raw(int& x, int& y, uint32_t& col); // set pixel without mapping (internal use only)
+    static void buildPaletteLUT();            // expand _currentPalette into _paletteLUT
+    // number of virtual pixels current effect draws into (whole pixel buffer), used by bulk operations on _pixels
+    inline unsigned virtualPixels() const { return std::min(is2D() ? _vWidth * _vHeight : _vLength, _pixelsLen); }
 
   public:
 
@@ -486,6 +507,7 @@ typedef struct Segment {
       check3(false),
       startY(0),
       stopY(1),
+      blendMode(SEG_BLEND_NORMAL),
       name(nullptr),
       next_time(0),
       step(0),
@@ -496,6 +518,8 @@ typedef struct Segment {
       _capabilities(0),
       _default_palette(0),
       _dataLen(0),
+      _pixels(nullptr),
+      _pixelsLen(0),
       _t(nullptr)
     {
       #ifdef WLED_DEBUG
@@ -521,13 +545,14 @@ typedef struct Segment {
       if (name) { delete[] name; name = nullptr; }
       stopTransition();
       deallocateData();
+      deallocatePixels();
     }
 
     Segment& operator= (const Segment &orig); // copy assignment
     Segment& operator= (Segment &&orig) noexcept; // move assignment
 
 #ifdef WLED_DEBUG
-    size_t getSize() const { return sizeof(Segment) + (data?_dataLen:0) + (name?strlen(name):0) + (_t?sizeof(Transition):0); }
+    size_t getSize() const { return sizeof(Segment) + (data?_dataLen:0) + (_pixels?_pixelsLen*sizeof(uint32_t):0) + (name?strlen(name):0) + (_t?sizeof(Transition):0); }
 #endif
 
     inline bool     getOption(uint8_t n) const { return ((options >> n) & 0x01); }
@@ -547,6 +572,9 @@ typedef struct Segment {
 
     inline static unsigned getUsedSegmentData()            { return Segment::_usedSegmentData; }
     inline static void     addUsedSegmentData(int len)     { Segment::_usedSegmentData += len; }
+    static unsigned getPeakSegmentData();            // high-water mark of used effect data (bytes, including block headers)
+    static unsigned getSegmentDataMoves();           // number of effect data arena compactions
+    static uint8_t  getSegmentDataFragmentation();   // fragmentation of free effect data space (%)
     #ifndef WLED_DISABLE_MODE_BLEND
     inline static void     modeBlend(bool blend)           { _modeBlend = blend; }
     #endif
@@ -571,9 +599,13 @@ typedef struct Segment {
 
     // runtime data functions
     inline uint16_t dataSize() const { return _dataLen; }
-    bool allocateData(size_t len);  // allocates effect data buffer in heap and clears it
-    void deallocateData();          // deallocates (frees) effect data buffer from heap
+    bool allocateData(size_t len);  // allocates effect data buffer in effect data arena and clears it
+    void deallocateData();          // deallocates (releases) effect data buffer
+    void relocateData(const byte *from, byte *to); // updates effect data pointers after effect data arena was compacted
     void resetIfRequired();         // sets all SEGENV variables to 0 and clears data buffer
+    bool allocatePixels();          // (re)allocates virtual pixel buffer to match segment geometry
+    void deallocatePixels();        // deallocates (frees) virtual pixel buffer
+    void compose(uint32_t *frame, uint8_t *frameCCT, unsigned frameLen) const; // blends segment layer(s) into strip frame (called from WS2812FX::show())
     /**
       * Flags that before the next effect is calculated,
       * the internal segment state should be reset.
@@ -661,7 +693,7 @@ typedef struct Segment {
     inline void addPixelColorXY(int x, int y, byte r, byte g, byte b, byte w = 0, bool preserveCR = true) { addPixelColorXY(x, y, RGBW32(r,g,b,w), preserveCR); }
     inline void addPixelColorXY(int x, int y, CRGB c, bool preserveCR = true)                             { addPixelColorXY(x, y, RGBW32(c.r,c.g,c.b,0), preserveCR); }
     inline void fadePixelColorXY(uint16_t x, uint16_t y, uint8_t fade)                   { setPixelColorXY(x, y, color_fade(getPixelColorXY(x,y), fade, true)); }
-    //void box_blur(unsigned r = 1U, bool smear = false); // 2D box blur
+    void box_blur(unsigned radiusX, unsigned radiusY, unsigned passes = 1); // 2D box blur, radius 1-8
     void blur2D(uint8_t blur_x, uint8_t blur_y, bool smear = false);
     void moveX(int delta, bool wrap = false);
     void moveY(int delta, bool wrap = false);
@@ -696,7 +728,7 @@ typedef struct Segment {
     inline void addPixelColorXY(int x, int y, byte r, byte g, byte b, byte w = 0, bool saturate = false) { addPixelColor(x, RGBW32(r,g,b,w), saturate); }
     inline void addPixelColorXY(int x, int y, CRGB c, bool saturate = false)         { addPixelColor(x, RGBW32(c.r,c.g,c.b,0), saturate); }
     inline void fadePixelColorXY(uint16_t x, uint16_t y, uint8_t fade)            { fadePixelColor(x, fade); }
-    //inline void box_blur(unsigned i, bool vertical, fract8 blur_amount) {}
+    inline void box_blur(unsigned radiusX, unsigned radiusY, unsigned passes = 1) {}
     inline void blur2D(uint8_t blur_x, uint8_t blur_y, bool smear = false) {}
     inline void blurRow(int row, fract8 blur_amount, bool smear = false) {}
     inline void blurCol(int col, fract8 blur_amount, bool smear = false) {}
@@ -765,6 +797,9 @@ class WS2812FX {  // 96 bytes
       _callback(nullptr),
       customMappingTable(nullptr),
       customMappingSize(0),
+      _pixels(nullptr),
+      _pixelCCT(nullptr),
+      _pixelsLen(0),
       _lastShow(0),
       _lastServiceShow(0),
       _segment_index(0),
@@ -779,6 +814,7 @@ class WS2812FX {  // 96 bytes
 
     ~WS2812FX() {
       if (customMappingTable) delete[] customMappingTable;
+      deallocateFrame();
       _mode.clear();
       _modeData.clear();
       _segments.clear();
@@ -796,6 +832,7 @@ class WS2812FX {  // 96 bytes
 #endif
       finalizeInit(),                             // initialises strip components
       service(),                                  // executes effect functions when due and calls strip.show()
+      compactSegmentData(),                       // closes holes in effect data arena (not while effects are running)
       setCCT(uint16_t k),                         // sets global CCT (either in relative 0-255 value or in K)
       setBrightness(uint8_t b, bool direct = false),    // sets strip brightness
       setRange(uint16_t i, uint16_t i2, uint32_t col),  // used for clock overlay
@@ -805,6 +842,7 @@ class WS2812FX {  // 96 bytes
       makeAutoSegments(bool forceReset = false),  // will create segments based on configured outputs
       fixInvalidSegments(),                       // fixes incorrect segment configuration
       setPixelColor(unsigned n, uint32_t c),      // paints absolute strip pixel with index n and color c
+      setPixelColors(unsigned n, unsigned count, const uint32_t *c), // paints count absolute strip pixels starting at index n
       show(),                                     // initiates LED output
       setTargetFps(unsigned fps),
       setupEffectData();                          // add default effects to the list; defined in FX.cpp
@@ -856,7 +894,8 @@ class WS2812FX {  // 96 bytes
 
     uint16_t
       getLengthPhysical() const,
-      getLengthTotal() const; // will include virtual/nonexistent pixels in matrix
+      getLengthTotal() const, // will include virtual/nonexistent pixels in matrix
+      runEffectFrame(unsigned n); // runs effect function of segment n once without showing it (used by effect benchmark)
 
     inline uint16_t getFps() const          { return (millis() - _lastShow > 2000) ? 0 : (FPS_MULTIPLIER * _cumulativeFps) >> FPS_CALC_SHIFT; } // Returns the refresh rate of the LED strip (_cumulativeFps is stored in fixed point)
     inline uint16_t getFrameTime() const    { return _frametime; }        // returns amount of time a frame should take (in ms)
@@ -966,11 +1005,19 @@ class WS2812FX {  // 96 bytes
     uint16_t* customMappingTable;
     uint16_t  customMappingSize;
 
+    uint32_t* _pixels;    // frame buffer segments are composited into (logical, unmapped pixel order)
+    uint8_t*  _pixelCCT;  // CCT of each pixel in frame buffer
+    unsigned  _pixelsLen;
+
     unsigned long _lastShow;
     unsigned long _lastServiceShow;
 
     uint8_t _segment_index;
     uint8_t _mainSegment;
+
+    bool allocateFrame();
+    void deallocateFrame();
+    void composeFrame();  // blends segment layers into frame buffer and sends it to buses
 };
 
 extern const char JSON_mode_names[];
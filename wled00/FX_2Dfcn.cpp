@@ -153,32 +153,6 @@ uint16_t IRAM_ATTR_YN Segment::XY(int x, int y)
   return isActive() ? (x%vW) + (y%vH) * vW : 0;
 }
 
-// raw setColor function without checks (checks are done in setPixelColorXY())
-void IRAM_ATTR_YN Segment::_setPixelColorXY_raw(int& x, int& y, uint32_t& col)
-{
-  const int baseX = start + x;
-  const int baseY = startY + y;
-#ifndef WLED_DISABLE_MODE_BLEND
-  // if blending modes, blend with underlying pixel
-  if (_modeBlend) col = color_blend16(strip.getPixelColorXY(baseX, baseY), col, 0xFFFFU - progress());
-#endif
-  strip.setPixelColorXY(baseX, baseY, col);
-
-  // Apply mirroring
-  if (mirror || mirror_y) {
-    auto setMirroredPixel = [&](int mx, int my) {
-      strip.setPixelColorXY(mx, my, col);
-    };
-
-    const int mirrorX = start + width() - x - 1;
-    const int mirrorY = startY + height() - y - 1;
-
-    if (mirror) setMirroredPixel(transpose ? baseX : mirrorX, transpose ? mirrorY : baseY);
-    if (mirror_y) setMirroredPixel(transpose ? mirrorX : baseX, transpose ? baseY : mirrorY);
-    if (mirror && mirror_y) setMirroredPixel(mirrorX, mirrorY);
-  }
-}
-
 void IRAM_ATTR_YN Segment::setPixelColorXY(int x, int y, uint32_t col)
 {
   if (!isActive()) return; // not active
@@ -188,29 +162,9 @@ void IRAM_ATTR_YN Segment::setPixelColorXY(int x, int y, uint32_t col)
   // negative values of x & y cast into unsigend will become very large values and will therefore be greater than vW/vH
   if (unsigned(x) >= unsigned(vW) || unsigned(y) >= unsigned(vH)) return;  // if pixel would fall out of virtual segment just exit
 
-  // if color is unscaled
-  if (!_colorScaled) col = color_fade(col, _segBri);
-
-  if (reverse  ) x = vW - x - 1;
-  if (reverse_y) y = vH - y - 1;
-  if (transpose) { std::swap(x,y); } // swap X & Y if segment transposed
-  unsigned groupLen = groupLength();
-
-  if (groupLen > 1) {
-    int W = width();
-    int H = height();
-    x *= groupLen; // expand to physical pixels
-    y *= groupLen; // expand to physical pixels
-    const int maxY = std::min(y + grouping, H);
-    const int maxX = std::min(x + grouping, W);
-    for (int yY = y; yY < maxY; yY++) {
-      for (int xX = x; xX < maxX; xX++) {
-        _setPixelColorXY_raw(xX, yY, col);
-      }
-    }
-  } else {
-    _setPixelColorXY_raw(x, y, col);
-  }
+  // virtual pixels are expanded to physical ones (reverse, transpose, grouping, mirror) in compose()
+  const unsigned i = x + y * vW;
+  if (i < _pixelsLen) _pixels[i] = col;
 }
 
 #ifdef WLED_USE_AA_PIXELS
@@ -262,13 +216,8 @@ uint32_t IRAM_ATTR_YN Segment::getPixelColorXY(int x, int y) const {
   const int vW = vWidth();
   const int vH = vHeight();
   if (unsigned(x) >= unsigned(vW) || unsigned(y) >= unsigned(vH)) return 0;  // if pixel would fall out of virtual segment just exit
-  if (reverse  ) x = vW - x - 1;
-  if (reverse_y) y = vH - y - 1;
-  if (transpose) { std::swap(x,y); } // swap X & Y if segment transposed
-  x *= groupLength(); // expand to physical pixels
-  y *= groupLength(); // expand to physical pixels
-  if (x >= width() || y >= height()) return 0;
-  return strip.getPixelColorXY(start + x, startY + y);
+  const unsigned i = x + y * vW;
+  return (i < _pixelsLen) ? _pixels[i] : 0;
 }
 
 // 2D blurring, can be asymmetrical
@@ -276,180 +225,56 @@ void Segment::blur2D(uint8_t blur_x, uint8_t blur_y, bool smear) {
   if (!isActive()) return; // not active
   const unsigned cols = vWidth();
   const unsigned rows = vHeight();
-  uint32_t lastnew;
-  uint32_t last;
+  if (!_pixels || cols * rows > _pixelsLen) return;
   if (blur_x) {
     const uint8_t keepx = smear ? 255 : 255 - blur_x;
     const uint8_t seepx = blur_x >> 1;
-    for (unsigned row = 0; row < rows; row++) { // blur rows (x direction)
-      uint32_t carryover = BLACK;
-      uint32_t curnew = BLACK;
-      for (unsigned x = 0; x < cols; x++) {
-        uint32_t cur = getPixelColorXY(x, row);
-        uint32_t part = color_fade(cur, seepx);
-        curnew = color_fade(cur, keepx);
-        if (x > 0) {
-          if (carryover) curnew = color_add(curnew, carryover);
-          uint32_t prev = color_add(lastnew, part);
-          // optimization: only set pixel if color has changed
-          if (last != prev) setPixelColorXY(x - 1, row, prev);
-        } else setPixelColorXY(x, row, curnew); // first pixel
-        lastnew = curnew;
-        last = cur; // save original value for comparison on next iteration
-        carryover = part;
-      }
-      setPixelColorXY(cols-1, row, curnew); // set last pixel
-    }
+    for (unsigned row = 0; row < rows; row++) color_blur_span(_pixels + row * cols, cols, 1, keepx, seepx); // blur rows (x direction)
   }
   if (blur_y) {
     const uint8_t keepy = smear ? 255 : 255 - blur_y;
     const uint8_t seepy = blur_y >> 1;
-    for (unsigned col = 0; col < cols; col++) {
-      uint32_t carryover = BLACK;
-      uint32_t curnew = BLACK;
-      for (unsigned y = 0; y < rows; y++) {
-        uint32_t cur = getPixelColorXY(col, y);
-        uint32_t part = color_fade(cur, seepy);
-        curnew = color_fade(cur, keepy);
-        if (y > 0) {
-          if (carryover) curnew = color_add(curnew, carryover);
-          uint32_t prev = color_add(lastnew, part);
-          // optimization: only set pixel if color has changed
-          if (last != prev) setPixelColorXY(col, y - 1, prev);
-        } else setPixelColorXY(col, y, curnew); // first pixel
-        lastnew = curnew;
-        last = cur; //save original value for comparison on next iteration
-        carryover = part;
-      }
-      setPixelColorXY(col, rows - 1, curnew);
-    }
+    for (unsigned col = 0; col < cols; col++) color_blur_span(_pixels + col, rows, cols, keepy, seepy); // blur columns (y direction)
   }
 }
 
-/*
-// 2D Box blur
-void Segment::box_blur(unsigned radius, bool smear) {
-  if (!isActive() || radius == 0) return; // not active
-  if (radius > 3) radius = 3;
-  const unsigned d = (1 + 2*radius) * (1 + 2*radius); // averaging divisor
+// line buffer for box_blur() (original values of row/column being blurred), kept between calls
+static uint32_t *boxBlurLine    = nullptr;
+static unsigned  boxBlurLineLen = 0;
+
+// 2D box blur (separable, sliding window sums: cost does not depend on radius), radius 1-8 for each direction (0 = none)
+// several passes approximate gaussian blur (3 passes are close enough)
+void Segment::box_blur(unsigned radiusX, unsigned radiusY, unsigned passes) {
+  if (!isActive() || (radiusX == 0 && radiusY == 0)) return; // not active
   const unsigned cols = vWidth();
   const unsigned rows = vHeight();
-  uint16_t *tmpRSum = new uint16_t[cols*rows];
-  uint16_t *tmpGSum = new uint16_t[cols*rows];
-  uint16_t *tmpBSum = new uint16_t[cols*rows];
-  uint16_t *tmpWSum = new uint16_t[cols*rows];
-  // fill summed-area table (https://en.wikipedia.org/wiki/Summed-area_table)
-  for (unsigned x = 0; x < cols; x++) {
-    unsigned rS, gS, bS, wS;
-    unsigned index;
-    rS = gS = bS = wS = 0;
-    for (unsigned y = 0; y < rows; y++) {
-      index = x * cols + y;
-      if (x > 0) {
-        unsigned index2 = (x - 1) * cols + y;
-        tmpRSum[index] = tmpRSum[index2];
-        tmpGSum[index] = tmpGSum[index2];
-        tmpBSum[index] = tmpBSum[index2];
-        tmpWSum[index] = tmpWSum[index2];
-      } else {
-        tmpRSum[index] = 0;
-        tmpGSum[index] = 0;
-        tmpBSum[index] = 0;
-        tmpWSum[index] = 0;
-      }
-      uint32_t c = getPixelColorXY(x, y);
-      rS += R(c);
-      gS += G(c);
-      bS += B(c);
-      wS += W(c);
-      tmpRSum[index] += rS;
-      tmpGSum[index] += gS;
-      tmpBSum[index] += bS;
-      tmpWSum[index] += wS;
-    }
+  if (!_pixels || cols * rows > _pixelsLen) return;
+  const unsigned len = max(cols, rows);
+  if (len > boxBlurLineLen) {
+    uint32_t *line = (uint32_t*)realloc(boxBlurLine, len * sizeof(uint32_t));
+    if (!line) return;
+    boxBlurLine    = line;
+    boxBlurLineLen = len;
   }
-  // do a box blur using pre-calculated sums
-  for (unsigned x = 0; x < cols; x++) {
-    for (unsigned y = 0; y < rows; y++) {
-      // sum = D + A - B - C where k = (x,y)
-      // +----+-+---- (x)
-      // |    | |
-      // +----A-B
-      // |    |k|
-      // +----C-D
-      // |
-      //(y)
-      unsigned x0 = x < radius ? 0 : x - radius;
-      unsigned y0 = y < radius ? 0 : y - radius;
-      unsigned x1 = x >= cols - radius ? cols - 1 : x + radius;
-      unsigned y1 = y >= rows - radius ? rows - 1 : y + radius;
-      unsigned A = x0 * cols + y0;
-      unsigned B = x1 * cols + y0;
-      unsigned C = x0 * cols + y1;
-      unsigned D = x1 * cols + y1;
-      unsigned r = tmpRSum[D] + tmpRSum[A] - tmpRSum[C] - tmpRSum[B];
-      unsigned g = tmpGSum[D] + tmpGSum[A] - tmpGSum[C] - tmpGSum[B];
-      unsigned b = tmpBSum[D] + tmpBSum[A] - tmpBSum[C] - tmpBSum[B];
-      unsigned w = tmpWSum[D] + tmpWSum[A] - tmpWSum[C] - tmpWSum[B];
-      setPixelColorXY(x, y, RGBW32(r/d, g/d, b/d, w/d));
-    }
+  for (unsigned p = 0; p < passes; p++) {
+    if (radiusX) for (unsigned row = 0; row < rows; row++) color_box_blur_span(_pixels + row * cols, cols, 1, radiusX, boxBlurLine);
+    if (radiusY) for (unsigned col = 0; col < cols; col++) color_box_blur_span(_pixels + col, rows, cols, radiusY, boxBlurLine);
   }
-  delete[] tmpRSum;
-  delete[] tmpGSum;
-  delete[] tmpBSum;
-  delete[] tmpWSum;
 }
-*/
 void Segment::moveX(int delta, bool wrap) {
   if (!isActive() || !delta) return; // not active
   const int vW = vWidth();   // segment width in logical pixels (can be 0 if segment is inactive)
   const int vH = vHeight();  // segment height in logical pixels (is always >= 1)
-  int absDelta = abs(delta);
-  if (absDelta >= vW) return;
-  uint32_t newPxCol[vW];
-  int newDelta;
-  int stop = vW;
-  int start = 0;
-  if (wrap) newDelta = (delta + vW) % vW; // +cols in case delta < 0
-  else {
-    if (delta < 0) start = absDelta;
-    stop = vW - absDelta;
-    newDelta = delta > 0 ? delta : 0;
-  }
-  for (int y = 0; y < vH; y++) {
-    for (int x = 0; x < stop; x++) {
-      int srcX = x + newDelta;
-      if (wrap) srcX %= vW; // Wrap using modulo when `wrap` is true
-      newPxCol[x] = getPixelColorXY(srcX, y);
-    }
-    for (int x = 0; x < stop; x++) setPixelColorXY(x + start, y, newPxCol[x]);
-  }
+  if (abs(delta) >= vW || !_pixels || unsigned(vW * vH) > _pixelsLen) return;
+  for (int y = 0; y < vH; y++) color_shift_span(_pixels + y * vW, vW, delta, wrap); // each row separately
 }
 
 void Segment::moveY(int delta, bool wrap) {
   if (!isActive() || !delta) return; // not active
   const int vW = vWidth();   // segment width in logical pixels (can be 0 if segment is inactive)
   const int vH = vHeight();  // segment height in logical pixels (is always >= 1)
-  int absDelta = abs(delta);
-  if (absDelta >= vH) return;
-  uint32_t newPxCol[vH];
-  int newDelta;
-  int stop = vH;
-  int start = 0;
-  if (wrap) newDelta = (delta + vH) % vH; // +rows in case delta < 0
-  else {
-    if (delta < 0) start = absDelta;
-    stop = vH - absDelta;
-    newDelta = delta > 0 ? delta : 0;
-  }
-  for (int x = 0; x < vW; x++) {
-    for (int y = 0; y < stop; y++) {
-      int srcY = y + newDelta;
-      if (wrap) srcY %= vH; // Wrap using modulo when `wrap` is true
-      newPxCol[y] = getPixelColorXY(x, srcY);
-    }
-    for (int y = 0; y < stop; y++) setPixelColorXY(x, y + start, newPxCol[y]);
-  }
+  if (abs(delta) >= vH || !_pixels || unsigned(vW * vH) > _pixelsLen) return;
+  color_shift_span(_pixels, vW * vH, delta * vW, wrap); // rows are contiguous so whole buffer is shifted by delta rows
 }
 
 // move() - move all pixels in desired direction delta number of pixels
@@ -504,9 +329,6 @@ void Segment::drawCircle(uint16_t cx, uint16_t cy, uint8_t radius, uint32_t col,
       x++;
     }
   } else {
-    // pre-scale color for all pixels
-    col = color_fade(col, _segBri);
-    _colorScaled = true;
     // Bresenham’s Algorithm
     int d = 3 - (2*radius);
     int y = radius, x = 0;
@@ -525,7 +347,6 @@ void Segment::drawCircle(uint16_t cx, uint16_t cy, uint8_t radius, uint32_t col,
         d += 4 * x + 6;
       }
     }
-    _colorScaled = false;
   }
 }
 
@@ -536,9 +357,6 @@ void Segment::fillCircle(uint16_t cx, uint16_t cy, uint8_t radius, uint32_t col,
   const int vH = vHeight();  // segment height in logical pixels (is always >= 1)
   // draw soft bounding circle
   if (soft) drawCircle(cx, cy, radius, col, soft);
-  // pre-scale color for all pixels
-  col = color_fade(col, _segBri);
-  _colorScaled = true;
   // fill it
   for (int y = -radius; y <= radius; y++) {
     for (int x = -radius; x <= radius; x++) {
@@ -548,7 +366,6 @@ void Segment::fillCircle(uint16_t cx, uint16_t cy, uint8_t radius, uint32_t col,
         setPixelColorXY(cx + x, cy + y, col);
     }
   }
-  _colorScaled = false;
 }
 
 //line function
@@ -594,9 +411,6 @@ void Segment::drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint3
       if (steep) std::swap(x,y);  // restore if steep
     }
   } else {
-    // pre-scale color for all pixels
-    c = color_fade(c, _segBri);
-    _colorScaled = true;
     // Bresenham's algorithm
     int err = (dx>dy ? dx : -dy)/2;   // error direction
     for (;;) {
@@ -606,7 +420,6 @@ void Segment::drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint3
       if (e2 >-dx) { err -= dy; x0 += sx; }
       if (e2 < dy) { err += dx; y0 += sy; }
     }
-    _colorScaled = false;
   }
 }
 
@@ -640,9 +453,6 @@ void Segment::drawCharacter(unsigned char chr, int16_t x, int16_t y, uint8_t w,
       default: return;
     }
     uint32_t c = ColorFromPaletteWLED(grad, (i+1)*255/h, 255, NOBLEND);
-    // pre-scale color for all pixels
-    c = color_fade(c, _segBri);
-    _colorScaled = true;
     for (int j = 0; j<w; j++) { // character width
       int x0, y0;
       switch (rotate) {
@@ -657,7 +467,6 @@ void Segment::drawCharacter(unsigned char chr, int16_t x, int16_t y, uint8_t w,
         setPixelColorXY(x0, y0, c);
       }
     }
-    _colorScaled = false;
   }
 }
 
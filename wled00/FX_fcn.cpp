@@ -74,8 +74,11 @@ unsigned      Segment::_vWidth            = 0;
 unsigned      Segment::_vHeight           = 0;
 uint8_t       Segment::_segBri            = 0;
 uint32_t      Segment::_currentColors[NUM_COLORS] = {0,0,0};
-bool          Segment::_colorScaled       = false;
 CRGBPalette16 Segment::_currentPalette    = CRGBPalette16(CRGB::Black);
+uint32_t      Segment::_paletteLUT[256];
+bool          Segment::_paletteLUTValid   = false;
+uint32_t      Segment::_paletteStep       = 0;
+bool          Segment::usePaletteLUT      = true;
 CRGBPalette16 Segment::_randomPalette     = generateRandomPalette();  // was CRGBPalette16(DEFAULT_COLOR);
 CRGBPalette16 Segment::_newRandomPalette  = generateRandomPalette();  // was CRGBPalette16(DEFAULT_COLOR);
 uint16_t      Segment::_lastPaletteChange = 0; // perhaps it should be per segment
@@ -86,6 +89,159 @@ uint16_t      Segment::_transitionprogress  = 0xFFFF;
 bool Segment::_modeBlend = false;
 #endif
 
+// Effect data arena
+// Effect data of all segments is carved out of a single region of MAX_SEGMENT_DATA bytes (reserved on first use)
+// instead of separate heap allocations, so that frequent mode changes (playlists) cannot fragment the heap.
+// Blocks are placed first-fit and adjacent released blocks are merged; remaining holes are closed by
+// WS2812FX::compactSegmentData() before segments are serviced (or when an allocation does not fit in any hole),
+// which moves blocks down and updates segment data pointers (effects must not keep pointers to SEGENV.data
+// between frames or across allocateData()).
+// Copies of effect data (Segment copies, previous effect during blending) are kept on heap so that only
+// segments in strip._segments refer to the arena; if the arena cannot be reserved, heap is used as well.
+typedef struct DataBlock {
+  uint32_t len     : 30; // payload length (multiple of 4)
+  uint32_t used    : 1;  // block holds data
+  uint32_t counted : 1;  // block counts against MAX_SEGMENT_DATA (not set for copies)
+} data_block_t;
+
+static uint8_t *dataArena       = nullptr;
+static unsigned dataArenaTop    = 0; // end of last block
+static unsigned dataArenaPeak   = 0; // high-water mark of used effect data (bytes, including block headers)
+static unsigned dataArenaHoles  = 0; // number of released blocks below dataArenaTop
+static unsigned dataArenaMoves  = 0; // number of compactions since boot
+
+#ifdef ARDUINO_ARCH_ESP32
+// effect data is also allocated and released by the async web server task (JSON API)
+static SemaphoreHandle_t dataArenaMutex = xSemaphoreCreateRecursiveMutex();
+  #define DATA_ARENA_LOCK()   xSemaphoreTakeRecursive(dataArenaMutex, portMAX_DELAY)
+  #define DATA_ARENA_UNLOCK() xSemaphoreGiveRecursive(dataArenaMutex)
+#else
+  #define DATA_ARENA_LOCK()
+  #define DATA_ARENA_UNLOCK()
+#endif
+
+// holds arena lock while in scope
+struct DataArenaLock {
+  DataArenaLock()  { DATA_ARENA_LOCK(); }
+  ~DataArenaLock() { DATA_ARENA_UNLOCK(); }
+};
+
+static inline data_block_t *arenaBlock(unsigned ofs) { return reinterpret_cast<data_block_t*>(dataArena + ofs); }
+static inline unsigned arenaBlockSize(unsigned ofs)  { return sizeof(data_block_t) + arenaBlock(ofs)->len; }
+static inline bool isInArena(const void *p)          { return dataArena && p >= dataArena && p < dataArena + MAX_SEGMENT_DATA; }
+static inline unsigned dataBlockSize(size_t len)     { return sizeof(data_block_t) + ((len + 3) & ~3U); } // blocks are 32 bit aligned
+
+static void countSegmentData(int size) {
+  Segment::addUsedSegmentData(size);
+  if (Segment::getUsedSegmentData() > dataArenaPeak) dataArenaPeak = Segment::getUsedSegmentData();
+}
+
+// returns nullptr if arena is full, fragmented or could not be reserved
+static byte *arenaAlloc(size_t len) {
+  if (!dataArena) {
+    dataArena = (uint8_t*)malloc(MAX_SEGMENT_DATA); // do not use SPI RAM on ESP32 since it is slow
+    if (!dataArena) return nullptr;
+  }
+  const unsigned need = dataBlockSize(len);
+  len = need - sizeof(data_block_t);
+  // first fit in released blocks, split if remainder can hold another block
+  for (unsigned ofs = 0; ofs < dataArenaTop; ofs += arenaBlockSize(ofs)) {
+    data_block_t *b = arenaBlock(ofs);
+    if (b->used || b->len < len) continue;
+    if (b->len >= need + 4) {
+      data_block_t *rest = arenaBlock(ofs + need);
+      rest->len     = b->len - need;
+      rest->used    = 0;
+      rest->counted = 1;
+      b->len = len;
+    } else dataArenaHoles--;
+    b->used = 1;
+    countSegmentData(sizeof(data_block_t) + b->len);
+    return (byte*)(b + 1);
+  }
+  if (dataArenaTop + need > MAX_SEGMENT_DATA) return nullptr;
+  data_block_t *b = arenaBlock(dataArenaTop);
+  b->len     = len;
+  b->used    = 1;
+  b->counted = 1;
+  dataArenaTop += need;
+  countSegmentData(need);
+  return (byte*)(b + 1);
+}
+
+static void arenaRelease(byte *p) {
+  data_block_t *b = reinterpret_cast<data_block_t*>(p) - 1;
+  b->used = 0;
+  countSegmentData(-int(sizeof(data_block_t) + b->len));
+  // merge adjacent released blocks and drop released blocks at the top
+  unsigned last = 0;
+  dataArenaHoles = 0;
+  for (unsigned ofs = 0; ofs < dataArenaTop; ofs += arenaBlockSize(ofs)) {
+    data_block_t *blk = arenaBlock(ofs);
+    if (!blk->used) {
+      while (ofs + arenaBlockSize(ofs) < dataArenaTop && !arenaBlock(ofs + arenaBlockSize(ofs))->used)
+        blk->len += arenaBlockSize(ofs + arenaBlockSize(ofs));
+      dataArenaHoles++;
+    }
+    last = ofs;
+  }
+  if (dataArenaTop && !arenaBlock(last)->used) {
+    dataArenaTop = last;
+    dataArenaHoles--;
+  }
+}
+
+// heap block with the same header as arena blocks
+static byte *heapAlloc(size_t len, bool counted) {
+  const unsigned size = dataBlockSize(len);
+  data_block_t *b = (data_block_t*)malloc(size);
+  if (!b) return nullptr;
+  b->len     = size - sizeof(data_block_t);
+  b->used    = 1;
+  b->counted = counted;
+  if (counted) countSegmentData(size);
+  return (byte*)(b + 1);
+}
+
+// copy of effect data outside of the arena (not moved by compaction and not counted against MAX_SEGMENT_DATA)
+// caller must hold arena lock while reading source pointer (it may be moved by compaction)
+static byte *copySegmentData(const byte *src, size_t len) {
+  byte *p = heapAlloc(len, false);
+  if (p) memcpy(p, src, len);
+  return p;
+}
+
+// releases effect data allocated by allocateData() or copySegmentData()
+static void releaseSegmentData(byte *p) {
+  if (!p) return;
+  DataArenaLock lock;
+  if (isInArena(p)) {
+    arenaRelease(p);
+    return;
+  }
+  data_block_t *b = reinterpret_cast<data_block_t*>(p) - 1;
+  if (b->counted) countSegmentData(-int(sizeof(data_block_t) + b->len));
+  free(b);
+}
+
+// fragmentation of free effect data space in percent (0 = all free space is contiguous)
+uint8_t Segment::getSegmentDataFragmentation() {
+  DataArenaLock lock;
+  if (!dataArena) return 0;
+  unsigned largest = MAX_SEGMENT_DATA - dataArenaTop;
+  unsigned total   = largest;
+  for (unsigned ofs = 0; dataArenaHoles && ofs < dataArenaTop; ofs += arenaBlockSize(ofs)) {
+    if (arenaBlock(ofs)->used) continue;
+    const unsigned size = arenaBlockSize(ofs);
+    total += size;
+    if (size > largest) largest = size;
+  }
+  return total ? 100 - (100 * largest) / total : 0;
+}
+
+unsigned Segment::getPeakSegmentData()   { return dataArenaPeak; }
+unsigned Segment::getSegmentDataMoves()  { return dataArenaMoves; }
+
 // copy constructor
 Segment::Segment(const Segment &orig) {
   //DEBUG_PRINTF_P(PSTR("-- Copy segment constructor: %p -> %p\n"), &orig, this);
@@ -94,8 +250,14 @@ Segment::Segment(const Segment &orig) {
   name = nullptr;
   data = nullptr;
   _dataLen = 0;
+  _pixels = nullptr;
+  _pixelsLen = 0;
   if (orig.name) { name = new char[strlen(orig.name)+1]; if (name) strcpy(name, orig.name); }
-  if (orig.data) { if (allocateData(orig._dataLen)) memcpy(data, orig.data, orig._dataLen); }
+  { // copies are kept out of effect data arena
+    DataArenaLock lock;
+    if (orig.data) { data = copySegmentData(orig.data, orig._dataLen); if (data) _dataLen = orig._dataLen; }
+  }
+  if (orig._pixels) { if (allocatePixels()) memcpy(_pixels, orig._pixels, min(_pixelsLen, orig._pixelsLen) * sizeof(uint32_t)); }
 }
 
 // move constructor
@@ -106,6 +268,8 @@ Segment::Segment(Segment &&orig) noexcept {
   orig.name = nullptr;
   orig.data = nullptr;
   orig._dataLen = 0;
+  orig._pixels = nullptr;
+  orig._pixelsLen = 0;
 }
 
 // copy assignment
@@ -116,14 +280,21 @@ Segment& Segment::operator= (const Segment &orig) {
     if (name) { delete[] name; name = nullptr; }
     stopTransition();
     deallocateData();
+    deallocatePixels();
     // copy source
     memcpy((void*)this, (void*)&orig, sizeof(Segment));
     // erase pointers to allocated data
     data = nullptr;
     _dataLen = 0;
+    _pixels = nullptr;
+    _pixelsLen = 0;
     // copy source data
     if (orig.name) { name = new char[strlen(orig.name)+1]; if (name) strcpy(name, orig.name); }
-    if (orig.data) { if (allocateData(orig._dataLen)) memcpy(data, orig.data, orig._dataLen); }
+    {
+      DataArenaLock lock;
+      if (orig.data) { data = copySegmentData(orig.data, orig._dataLen); if (data) _dataLen = orig._dataLen; }
+    }
+    if (orig._pixels) { if (allocatePixels()) memcpy(_pixels, orig._pixels, min(_pixelsLen, orig._pixelsLen) * sizeof(uint32_t)); }
   }
   return *this;
 }
@@ -135,53 +306,97 @@ Segment& Segment::operator= (Segment &&orig) noexcept {
     if (name) { delete[] name; name = nullptr; } // free old name
     stopTransition();
     deallocateData(); // free old runtime data
+    deallocatePixels(); // free old pixel buffer
     memcpy((void*)this, (void*)&orig, sizeof(Segment));
     orig.name = nullptr;
     orig.data = nullptr;
     orig._dataLen = 0;
+    orig._pixels = nullptr;
+    orig._pixelsLen = 0;
     orig._t   = nullptr; // old segment cannot be in transition
   }
   return *this;
 }
 
-// allocates effect data buffer on heap and initialises (erases) it
+// allocates effect data buffer in effect data arena and initialises (erases) it
 bool IRAM_ATTR_YN Segment::allocateData(size_t len) {
   if (len == 0) return false; // nothing to do
+  DataArenaLock lock;
   if (data && _dataLen >= len) {          // already allocated enough (reduce fragmentation)
     if (call == 0) memset(data, 0, len);  // erase buffer if called during effect initialisation
     return true;
   }
   //DEBUG_PRINTF_P(PSTR("--   Allocating data (%d): %p\n", len, this);
   deallocateData(); // if the old buffer was smaller release it first
-  if (Segment::getUsedSegmentData() + len > MAX_SEGMENT_DATA) {
+  if (Segment::getUsedSegmentData() + dataBlockSize(len) > MAX_SEGMENT_DATA) { // block header & alignment count as well
     // not enough memory
     DEBUG_PRINT(F("!!! Effect RAM depleted: "));
     DEBUG_PRINTF_P(PSTR("%d/%d !!!\n"), len, Segment::getUsedSegmentData());
     errorFlag = ERR_NORAM;
     return false;
   }
-  // do not use SPI RAM on ESP32 since it is slow
-  data = (byte*)calloc(len, sizeof(byte));
-  if (!data) { DEBUG_PRINTLN(F("!!! Allocation failed. !!!")); return false; } // allocation failed
-  Segment::addUsedSegmentData(len);
+  data = arenaAlloc(len);
+  if (!data && dataArenaHoles) {
+    // arena is fragmented, effect needs its data in this frame (init is skipped once call > 0)
+    #ifndef WLED_DISABLE_MODE_BLEND
+    if (_modeBlend) data = heapAlloc(len, true); // new effect's data pointer is swapped out and would not be relocated
+    else
+    #endif
+    {
+      strip.compactSegmentData(); // this segment's data was released above, pointers of other segments are updated
+      data = arenaAlloc(len);
+    }
+  }
+  if (!data && !dataArena) data = heapAlloc(len, true); // arena could not be reserved
+  if (!data) {
+    DEBUG_PRINTF_P(PSTR("!!! Effect data allocation failed: %d/%d (%d%% fragmented) !!!\n"), len, Segment::getUsedSegmentData(), getSegmentDataFragmentation());
+    return false;
+  }
+  memset(data, 0, len);
   //DEBUG_PRINTF_P(PSTR("---  Allocated data (%p): %d/%d -> %p\n"), this, len, Segment::getUsedSegmentData(), data);
   _dataLen = len;
   return true;
 }
 
 void IRAM_ATTR_YN Segment::deallocateData() {
-  if (!data) { _dataLen = 0; return; }
+  DataArenaLock lock;
   //DEBUG_PRINTF_P(PSTR("---  Released data (%p): %d/%d -> %p\n"), this, _dataLen, Segment::getUsedSegmentData(), data);
-  if ((Segment::getUsedSegmentData() > 0) && (_dataLen > 0)) { // check that we don't have a dangling / inconsistent data pointer
-    free(data);
-  } else {
-    DEBUG_PRINTF_P(PSTR("---- Released data (%p): inconsistent UsedSegmentData (%d/%d), cowardly refusing to free nothing.\n"), this, _dataLen, Segment::getUsedSegmentData());
-  }
+  releaseSegmentData(data); // may also be a copy made by startTransition() if called by previous effect during blending
   data = nullptr;
-  Segment::addUsedSegmentData(_dataLen <= Segment::getUsedSegmentData() ? -_dataLen : -Segment::getUsedSegmentData());
   _dataLen = 0;
 }
 
+// updates data pointers after effect data arena has been compacted
+void Segment::relocateData(const byte *from, byte *to) {
+  if (data == from) data = to;
+  #ifndef WLED_DISABLE_MODE_BLEND
+  if (_t && _t->_segT._dataT == from) _t->_segT._dataT = to;
+  #endif
+}
+
+// allocates (or resizes) virtual pixel buffer to match current segment geometry; new buffer is cleared
+bool Segment::allocatePixels() {
+  const unsigned len = isActive() ? virtualWidth() * virtualHeight() : 0;
+  if (len == _pixelsLen && _pixels) return true; // geometry did not change
+  deallocatePixels();
+  if (len == 0) return false;
+  // do not use SPI RAM on ESP32 since it is slow
+  _pixels = (uint32_t*)calloc(len, sizeof(uint32_t));
+  if (!_pixels) {
+    DEBUG_PRINTLN(F("!!! Pixel buffer allocation failed. !!!"));
+    errorFlag = ERR_NORAM;
+    return false;
+  }
+  _pixelsLen = len;
+  return true;
+}
+
+void Segment::deallocatePixels() {
+  free(_pixels); // free(nullptr) is a no-op
+  _pixels = nullptr;
+  _pixelsLen = 0;
+}
+
 /**
   * If reset of this segment was requested, clears runtime
   * settings of this segment.
@@ -197,6 +412,68 @@ void Segment::resetIfRequired() {
   reset = false;
 }
 
+// cache of expanded palettes generated from segment colors (2-5) and gradient palettes (13+)
+// so that beginDraw() does not regenerate them every frame for every segment
+#ifndef WLED_PALETTE_CACHE_SIZE
+  #ifdef ESP8266
+    #define WLED_PALETTE_CACHE_SIZE 4
+  #else
+    #define WLED_PALETTE_CACHE_SIZE 8
+  #endif
+#endif
+
+// minimum segment length for which color_from_palette() uses 256 color lookup table instead of blending
+// each color (table is built once per frame on first palette lookup)
+#ifndef WLED_PALETTE_LUT_MIN
+  #define WLED_PALETTE_LUT_MIN 128
+#endif
+
+typedef struct PaletteCacheEntry {
+  uint32_t      key[3];  // gamma corrected colors palette was generated from (unused are 0)
+  uint16_t      age;     // last use (least recently used entry is replaced)
+  uint8_t       id;      // palette id (0: empty entry)
+  CRGBPalette16 palette;
+} palette_cache_t;
+
+static palette_cache_t paletteCache[WLED_PALETTE_CACHE_SIZE];
+static uint16_t        paletteCacheClock = 0;
+
+static const CRGBPalette16 &getCachedPalette(uint8_t pal, const uint32_t *key) {
+  paletteCacheClock++;
+  palette_cache_t *entry = &paletteCache[0];
+  for (auto &e : paletteCache) {
+    if (e.id == pal && e.key[0] == key[0] && e.key[1] == key[1] && e.key[2] == key[2]) {
+      e.age = paletteCacheClock;
+      return e.palette;
+    }
+    if (uint16_t(paletteCacheClock - e.age) > uint16_t(paletteCacheClock - entry->age)) entry = &e;
+  }
+  CRGB prim = key[0];
+  CRGB sec  = key[1];
+  CRGB ter  = key[2] & 0x00FFFFFF;
+  switch (pal) {
+    case 2: //primary color only
+      entry->palette = CRGBPalette16(prim); break;
+    case 3: //primary + secondary
+      entry->palette = CRGBPalette16(prim,prim,sec,sec); break;
+    case 4: //primary + secondary + tertiary
+      entry->palette = CRGBPalette16(ter,sec,prim); break;
+    case 5: //primary + secondary (+tertiary if not off), more distinct
+      if (key[2]) entry->palette = CRGBPalette16(prim,prim,prim,prim,prim,sec,sec,sec,sec,sec,ter,ter,ter,ter,ter,prim);
+      else        entry->palette = CRGBPalette16(prim,prim,prim,prim,prim,prim,prim,prim,sec,sec,sec,sec,sec,sec,sec,sec);
+      break;
+    default: { //progmem gradient palettes
+      byte tcp[72];
+      memcpy_P(tcp, (byte*)pgm_read_dword(&(gGradientPalettes[pal-13])), 72);
+      entry->palette.loadDynamicGradientPalette(tcp);
+      break; }
+  }
+  entry->id  = pal;
+  entry->age = paletteCacheClock;
+  memcpy(entry->key, key, sizeof(entry->key));
+  return entry->palette;
+}
+
 CRGBPalette16 &Segment::loadPalette(CRGBPalette16 &targetPalette, uint8_t pal) {
   if (pal < 245 && pal > GRADIENT_PALETTE_COUNT+13) pal = 0;
   if (pal > 245 && (strip.customPalettes.size() == 0 || 255U-pal > strip.customPalettes.size()-1)) pal = 0; // TODO remove strip dependency by moving customPalettes out of strip
@@ -208,27 +485,11 @@ CRGBPalette16 &Segment::loadPalette(CRGBPalette16 &targetPalette, uint8_t pal) {
     case 1: //randomly generated palette
       targetPalette = _randomPalette; //random palette is generated at intervals in handleRandomPalette()
       break;
-    case 2: {//primary color only
-      CRGB prim = gamma32(colors[0]);
-      targetPalette = CRGBPalette16(prim); break;}
-    case 3: {//primary + secondary
-      CRGB prim = gamma32(colors[0]);
-      CRGB sec  = gamma32(colors[1]);
-      targetPalette = CRGBPalette16(prim,prim,sec,sec); break;}
-    case 4: {//primary + secondary + tertiary
-      CRGB prim = gamma32(colors[0]);
-      CRGB sec  = gamma32(colors[1]);
-      CRGB ter  = gamma32(colors[2]);
-      targetPalette = CRGBPalette16(ter,sec,prim); break;}
-    case 5: {//primary + secondary (+tertiary if not off), more distinct
-      CRGB prim = gamma32(colors[0]);
-      CRGB sec  = gamma32(colors[1]);
-      if (colors[2]) {
-        CRGB ter = gamma32(colors[2]);
-        targetPalette = CRGBPalette16(prim,prim,prim,prim,prim,sec,sec,sec,sec,sec,ter,ter,ter,ter,ter,prim);
-      } else {
-        targetPalette = CRGBPalette16(prim,prim,prim,prim,prim,prim,prim,prim,sec,sec,sec,sec,sec,sec,sec,sec);
-      }
+    case 2: case 3: case 4: case 5: { //palettes generated from primary, secondary & tertiary color
+      uint32_t key[3] = {0, 0, 0};
+      for (unsigned i = 0; i < NUM_COLORS && i < pal-1U; i++) key[i] = gamma32(colors[i]) & 0x00FFFFFF; // white is not used in palettes
+      if (pal == 5 && colors[2]) key[2] |= 0xFF000000; // tertiary color is used if set (even if gamma corrected to black)
+      targetPalette = getCachedPalette(pal, key);
       break;}
     default: //progmem palettes
       if (pal>245) {
@@ -236,9 +497,8 @@ CRGBPalette16 &Segment::loadPalette(CRGBPalette16 &targetPalette, uint8_t pal) {
       } else if (pal < 13) { // palette 6 - 12, fastled palettes
         targetPalette = *fastledPalettes[pal-6];
       } else {
-        byte tcp[72];
-        memcpy_P(tcp, (byte*)pgm_read_dword(&(gGradientPalettes[pal-13])), 72);
-        targetPalette.loadDynamicGradientPalette(tcp);
+        const uint32_t key[3] = {0, 0, 0};
+        targetPalette = getCachedPalette(pal, key);
       }
       break;
   }
@@ -266,12 +526,20 @@ void Segment::startTransition(uint16_t dur) {
     _t->_modeT          = mode;
     _t->_segT._dataLenT = 0;
     _t->_segT._dataT    = nullptr;
+    DataArenaLock lock;
     if (_dataLen > 0 && data) {
-      _t->_segT._dataT = (byte *)malloc(_dataLen);
-      if (_t->_segT._dataT) {
-        //DEBUG_PRINTF_P(PSTR("--  Allocated duplicate data (%d) for %p: %p\n"), _dataLen, this, _t->_segT._dataT);
-        memcpy(_t->_segT._dataT, data, _dataLen);
-        _t->_segT._dataLenT = _dataLen;
+      _t->_segT._dataT = copySegmentData(data, _dataLen);
+      //DEBUG_PRINTF_P(PSTR("--  Allocated duplicate data (%d) for %p: %p\n"), _dataLen, this, _t->_segT._dataT);
+      if (_t->_segT._dataT) _t->_segT._dataLenT = _dataLen;
+    }
+    // previous effect keeps drawing into its own layer (initialised with its last frame)
+    _t->_segT._pixelsLenT = 0;
+    _t->_segT._pixelsT    = nullptr;
+    if (_pixelsLen > 0 && _pixels) {
+      _t->_segT._pixelsT = (uint32_t *)malloc(_pixelsLen * sizeof(uint32_t));
+      if (_t->_segT._pixelsT) {
+        memcpy(_t->_segT._pixelsT, _pixels, _pixelsLen * sizeof(uint32_t));
+        _t->_segT._pixelsLenT = _pixelsLen;
       }
     }
   } else {
@@ -288,10 +556,13 @@ void Segment::stopTransition() {
     #ifndef WLED_DISABLE_MODE_BLEND
     if (_t->_segT._dataT && _t->_segT._dataLenT > 0) {
       //DEBUG_PRINTF_P(PSTR("--  Released duplicate data (%d) for %p: %p\n"), _t->_segT._dataLenT, this, _t->_segT._dataT);
-      free(_t->_segT._dataT);
+      releaseSegmentData(_t->_segT._dataT); // previous effect may have (re)allocated its data during blending
       _t->_segT._dataT = nullptr;
       _t->_segT._dataLenT = 0;
     }
+    free(_t->_segT._pixelsT); // free(nullptr) is a no-op
+    _t->_segT._pixelsT = nullptr;
+    _t->_segT._pixelsLenT = 0;
     #endif
     delete _t;
     _t = nullptr;
@@ -326,6 +597,8 @@ void Segment::swapSegenv(tmpsegd_t &tmpSeg) {
   tmpSeg._callT      = call;
   tmpSeg._dataT      = data;
   tmpSeg._dataLenT   = _dataLen;
+  tmpSeg._pixelsT    = _pixels;
+  tmpSeg._pixelsLenT = _pixelsLen;
   if (_t && &tmpSeg != &(_t->_segT)) {
     // swap SEGENV with transitional data
     options   = _t->_segT._optionsT;
@@ -344,6 +617,8 @@ void Segment::swapSegenv(tmpsegd_t &tmpSeg) {
     call      = _t->_segT._callT;
     data      = _t->_segT._dataT;
     _dataLen  = _t->_segT._dataLenT;
+    _pixels   = _t->_segT._pixelsT;
+    _pixelsLen = _t->_segT._pixelsLenT;
   }
 }
 
@@ -358,6 +633,8 @@ void Segment::restoreSegenv(tmpsegd_t &tmpSeg) {
     //if (_t->_segT._dataT != data) DEBUG_PRINTF_P(PSTR("---  data re-allocated: (%p) %p -> %p\n"), this, _t->_segT._dataT, data);
     _t->_segT._dataT = data;
     _t->_segT._dataLenT = _dataLen;
+    _t->_segT._pixelsT = _pixels;
+    _t->_segT._pixelsLenT = _pixelsLen;
   }
   options   = tmpSeg._optionsT;
   for (size_t i=0; i<NUM_COLORS; i++) colors[i] = tmpSeg._colorT[i];
@@ -375,6 +652,8 @@ void Segment::restoreSegenv(tmpsegd_t &tmpSeg) {
   call      = tmpSeg._callT;
   data      = tmpSeg._dataT;
   _dataLen  = tmpSeg._dataLenT;
+  _pixels   = tmpSeg._pixelsT;
+  _pixelsLen = tmpSeg._pixelsLenT;
 }
 #endif
 
@@ -411,6 +690,10 @@ void Segment::beginDraw() {
   _vHeight = virtualHeight();
   _vLength = virtualLength();
   _segBri  = currentBri();
+  #ifndef WLED_DISABLE_MODE_BLEND
+  if (!_modeBlend) // old effect (while blending) may have different options, it draws into its own layer of the same size
+  #endif
+  allocatePixels(); // make sure pixel buffer matches geometry
   // adjust gamma for effects
   for (unsigned i = 0; i < NUM_COLORS; i++) {
     #ifndef WLED_DISABLE_MODE_BLEND
@@ -431,6 +714,9 @@ void Segment::beginDraw() {
     for (unsigned i = 0; i < noOfBlends; i++, _t->_prevPaletteBlends++) nblendPaletteTowardPalette(_t->_palT, _currentPalette, 48);
     _currentPalette = _t->_palT; // copy transitioning/temporary palette
   }
+  _paletteLUTValid = false; // palette may have changed, LUT is rebuilt on first use
+  // fixed point step is exact for up to 4096 pixels (verified against (i*255)/(vL-1))
+  _paletteStep = (_vLength > 1 && _vLength <= 4096) ? (255U << 24) / (_vLength - 1) + 1 : 0;
 }
 
 // relies on WS2812FX::service() to call it for each frame
@@ -470,11 +756,8 @@ void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, ui
   stateChanged = true; // send UDP/WS broadcast
 
   if (stop || spc != spacing || m12 != map1D2D) {
-    _vWidth  = virtualWidth();
-    _vHeight = virtualHeight();
-    _vLength = virtualLength();
-    _segBri  = currentBri();
-    fill(BLACK); // turn old segment range off or clears pixels if changing spacing (requires _vWidth/_vHeight/_vLength/_segBri)
+    // clear pixels (old segment range is cleared as strip frame is recomposited on each show())
+    if (_pixels) memset(_pixels, 0, _pixelsLen * sizeof(uint32_t));
   }
   if (grp) { // prevent assignment of 0
     grouping = grp;
@@ -720,9 +1003,6 @@ void IRAM_ATTR_YN Segment::setPixelColor(int i, uint32_t col)
   if (is2D()) {
     const int vW = vWidth();   // segment width in logical pixels (can be 0 if segment is inactive)
     const int vH = vHeight();  // segment height in logical pixels (is always >= 1)
-    // pre-scale color for all pixels
-    col = color_fade(col, _segBri);
-    _colorScaled = true;
     switch (map1D2D) {
       case M12_Pixels:
         // use all available pixels as a long strip
@@ -814,7 +1094,6 @@ void IRAM_ATTR_YN Segment::setPixelColor(int i, uint32_t col)
         break;
       }
     }
-    _colorScaled = false;
     return;
   } else if (Segment::maxHeight != 1 && (width() == 1 || height() == 1)) {
     if (start < Segment::maxWidth*Segment::maxHeight) {
@@ -828,43 +1107,8 @@ void IRAM_ATTR_YN Segment::setPixelColor(int i, uint32_t col)
   }
 #endif
 
-  unsigned len = length();
-  // if color is unscaled
-  if (!_colorScaled) col = color_fade(col, _segBri);
-
-  // expand pixel (taking into account start, grouping, spacing [and offset])
-  i = i * groupLength();
-  if (reverse) { // is segment reversed?
-    if (mirror) { // is segment mirrored?
-      i = (len - 1) / 2 - i;  //only need to index half the pixels
-    } else {
-      i = (len - 1) - i;
-    }
-  }
-  i += start; // starting pixel in a group
-
-  uint32_t tmpCol = col;
-  // set all the pixels in the group
-  for (int j = 0; j < grouping; j++) {
-    unsigned indexSet = i + ((reverse) ? -j : j);
-    if (indexSet >= start && indexSet < stop) {
-      if (mirror) { //set the corresponding mirrored pixel
-        unsigned indexMir = stop - indexSet + start - 1;
-        indexMir += offset; // offset/phase
-        if (indexMir >= stop) indexMir -= len; // wrap
-#ifndef WLED_DISABLE_MODE_BLEND
-        if (_modeBlend) tmpCol = color_blend16(strip.getPixelColor(indexMir), col, uint16_t(0xFFFFU - progress()));
-#endif
-        strip.setPixelColor(indexMir, tmpCol);
-      }
-      indexSet += offset; // offset/phase
-      if (indexSet >= stop) indexSet -= len; // wrap
-#ifndef WLED_DISABLE_MODE_BLEND
-      if (_modeBlend) tmpCol = color_blend16(strip.getPixelColor(indexSet), col, uint16_t(0xFFFFU - progress()));
-#endif
-      strip.setPixelColor(indexSet, tmpCol);
-    }
-  }
+  // virtual pixels are expanded to physical ones (grouping, spacing, mirror, offset) in compose()
+  if (unsigned(i) < _pixelsLen) _pixels[i] = col;
 }
 
 #ifdef WLED_USE_AA_PIXELS
@@ -962,13 +1206,112 @@ uint32_t IRAM_ATTR_YN Segment::getPixelColor(int i) const
   }
 #endif
 
-  if (reverse) i = vLength() - i - 1;
-  i *= groupLength();
-  i += start;
-  // offset/phase
-  i += offset;
-  if (i >= stop) i -= length();
-  return strip.getPixelColor(i);
+  return (unsigned(i) < _pixelsLen) ? _pixels[i] : 0;
+}
+
+// blends segment pixel onto underlying (frame) pixel using blending mode and opacity
+static uint32_t IRAM_ATTR_YN blendSegmentPixel(uint32_t dst, uint32_t src, uint8_t mode, uint8_t opacity) {
+  switch (mode) {
+    case SEG_BLEND_ADD:
+      return color_add(dst, color_fade(src, opacity));
+    case SEG_BLEND_MULTIPLY: {
+      uint32_t mul = RGBW32((R(dst)*R(src)+255)>>8, (G(dst)*G(src)+255)>>8, (B(dst)*B(src)+255)>>8, (W(dst)*W(src)+255)>>8);
+      return opacity == 255 ? mul : color_blend(dst, mul, opacity);
+    }
+    case SEG_BLEND_MAX:
+      src = color_fade(src, opacity);
+      return RGBW32(max(R(dst),R(src)), max(G(dst),G(src)), max(B(dst),B(src)), max(W(dst),W(src)));
+    default: // SEG_BLEND_NORMAL
+      return opacity == 255 ? src : color_blend(dst, src, opacity);
+  }
+}
+
+// blends virtual pixel buffer (and previous effect's layer while in transition) into strip frame
+// takes into account start, grouping, spacing, reverse, mirror, transpose and offset
+// opacity (segment brightness) is applied according to blending mode
+void IRAM_ATTR_YN Segment::compose(uint32_t *frame, uint8_t *frameCCT, unsigned frameLen) const {
+  if (!isActive() || !_pixels) return;
+  const int vW = virtualWidth();
+  const int vH = virtualHeight();
+  if (unsigned(vW * vH) != _pixelsLen) return; // geometry changed but buffer was not yet reallocated (next beginDraw() will do it)
+  const uint8_t bri = currentBri();
+  if (bri == 0) return; // fully transparent in every blending mode
+  const uint8_t  segCCT   = currentBri(true);
+  const unsigned groupLen = groupLength();
+  const uint16_t prog     = progress();
+  const uint32_t *oldPixels = nullptr; // previous effect's layer
+#ifndef WLED_DISABLE_MODE_BLEND
+  if (modeBlending && prog < 0xFFFFU && _t->_modeT != mode && _t->_segT._pixelsLenT == _pixelsLen) oldPixels = _t->_segT._pixelsT;
+#endif
+
+  auto setFramePixel = [&](unsigned idx, uint32_t col) {
+    if (idx >= frameLen) return;
+    frame[idx] = blendSegmentPixel(frame[idx], col, blendMode, bri);
+    if (frameCCT) frameCCT[idx] = segCCT;
+  };
+
+#ifndef WLED_DISABLE_2D
+  if (is2D() || (Segment::maxHeight > 1 && start < Segment::maxWidth*Segment::maxHeight)) {
+    // 2D segment or vertical/horizontal 1D segment within matrix
+    const int W = width();
+    const int H = height();
+    for (int y = 0; y < vH; y++) for (int x = 0; x < vW; x++) {
+      const unsigned i = x + y * vW;
+      const uint32_t col = oldPixels ? color_blend16(oldPixels[i], _pixels[i], prog) : _pixels[i];
+      int pX = reverse   ? vW - x - 1 : x;
+      int pY = reverse_y ? vH - y - 1 : y;
+      if (transpose) std::swap(pX, pY); // swap X & Y if segment transposed
+      pX *= groupLen; // expand to physical pixels
+      pY *= groupLen; // expand to physical pixels
+      const int maxY = std::min(pY + grouping, H);
+      const int maxX = std::min(pX + grouping, W);
+      for (int yY = pY; yY < maxY; yY++) for (int xX = pX; xX < maxX; xX++) {
+        const int baseX = start + xX;
+        const int baseY = startY + yY;
+        setFramePixel(baseY * Segment::maxWidth + baseX, col);
+        // apply mirroring
+        if (mirror || mirror_y) {
+          const int mirrorX = start + W - xX - 1;
+          const int mirrorY = startY + H - yY - 1;
+          if (mirror)             setFramePixel((transpose ? mirrorY : baseY) * Segment::maxWidth + (transpose ? baseX : mirrorX), col);
+          if (mirror_y)           setFramePixel((transpose ? baseY : mirrorY) * Segment::maxWidth + (transpose ? mirrorX : baseX), col);
+          if (mirror && mirror_y) setFramePixel(mirrorY * Segment::maxWidth + mirrorX, col);
+        }
+      }
+    }
+    return;
+  }
+#endif
+
+  const unsigned len = length();
+  for (unsigned v = 0; v < _pixelsLen; v++) {
+    const uint32_t col = oldPixels ? color_blend16(oldPixels[v], _pixels[v], prog) : _pixels[v];
+    // expand pixel (taking into account start, grouping, spacing [and offset])
+    int i = v * groupLen;
+    if (reverse) { // is segment reversed?
+      if (mirror) { // is segment mirrored?
+        i = (len - 1) / 2 - i;  //only need to index half the pixels
+      } else {
+        i = (len - 1) - i;
+      }
+    }
+    i += start; // starting pixel in a group
+    // set all the pixels in the group
+    for (int j = 0; j < grouping; j++) {
+      unsigned indexSet = i + ((reverse) ? -j : j);
+      if (indexSet >= start && indexSet < stop) {
+        if (mirror) { //set the corresponding mirrored pixel
+          unsigned indexMir = stop - indexSet + start - 1;
+          indexMir += offset; // offset/phase
+          if (indexMir >= stop) indexMir -= len; // wrap
+          setFramePixel(indexMir, col);
+        }
+        indexSet += offset; // offset/phase
+        if (indexSet >= stop) indexSet -= len; // wrap
+        setFramePixel(indexSet, col);
+      }
+    }
+  }
 }
 
 uint8_t Segment::differs(const Segment& b) const {
@@ -979,6 +1322,7 @@ uint8_t Segment::differs(const Segment& b) const {
   if (grouping != b.grouping)   d |= SEG_DIFFERS_GSO;
   if (spacing != b.spacing)     d |= SEG_DIFFERS_GSO;
   if (opacity != b.opacity)     d |= SEG_DIFFERS_BRI;
+  if (blendMode != b.blendMode) d |= SEG_DIFFERS_BRI;
   if (mode != b.mode)           d |= SEG_DIFFERS_FX;
   if (speed != b.speed)         d |= SEG_DIFFERS_FX;
   if (intensity != b.intensity) d |= SEG_DIFFERS_FX;
@@ -1050,70 +1394,22 @@ void Segment::refreshLightCapabilities() {
  * Fills segment with color
  */
 void Segment::fill(uint32_t c) {
-  if (!isActive()) return; // not active
-  const int cols = is2D() ? vWidth() : vLength();
-  const int rows = vHeight(); // will be 1 for 1D
-  // pre-scale color for all pixels
-  c = color_fade(c, _segBri);
-  _colorScaled = true;
-  for (int y = 0; y < rows; y++) for (int x = 0; x < cols; x++) {
-    if (is2D()) setPixelColorXY(x, y, c);
-    else        setPixelColor(x, c);
-  }
-  _colorScaled = false;
+  if (!isActive() || !_pixels) return; // not active
+  std::fill_n(_pixels, virtualPixels(), c);
 }
 
 /*
  * fade out function, higher rate = quicker fade
  */
 void Segment::fade_out(uint8_t rate) {
-  if (!isActive()) return; // not active
-  const int cols = is2D() ? vWidth() : vLength();
-  const int rows = vHeight(); // will be 1 for 1D
-
-  rate = (255-rate) >> 1;
-  float mappedRate = 1.0f / (float(rate) + 1.1f);
-
-  uint32_t color = colors[1]; // SEGCOLOR(1); // target color
-  int w2 = W(color);
-  int r2 = R(color);
-  int g2 = G(color);
-  int b2 = B(color);
-
-  for (int y = 0; y < rows; y++) for (int x = 0; x < cols; x++) {
-    color = is2D() ? getPixelColorXY(x, y) : getPixelColor(x);
-    if (color == colors[1]) continue; // already at target color
-    int w1 = W(color);
-    int r1 = R(color);
-    int g1 = G(color);
-    int b1 = B(color);
-
-    int wdelta = (w2 - w1) * mappedRate;
-    int rdelta = (r2 - r1) * mappedRate;
-    int gdelta = (g2 - g1) * mappedRate;
-    int bdelta = (b2 - b1) * mappedRate;
-
-    // if fade isn't complete, make sure delta is at least 1 (fixes rounding issues)
-    wdelta += (w2 == w1) ? 0 : (w2 > w1) ? 1 : -1;
-    rdelta += (r2 == r1) ? 0 : (r2 > r1) ? 1 : -1;
-    gdelta += (g2 == g1) ? 0 : (g2 > g1) ? 1 : -1;
-    bdelta += (b2 == b1) ? 0 : (b2 > b1) ? 1 : -1;
-
-    if (is2D()) setPixelColorXY(x, y, r1 + rdelta, g1 + gdelta, b1 + bdelta, w1 + wdelta);
-    else        setPixelColor(x, r1 + rdelta, g1 + gdelta, b1 + bdelta, w1 + wdelta);
-  }
+  if (!isActive() || !_pixels) return; // not active
+  color_fade_toward_span(_pixels, virtualPixels(), colors[1], rate); // fade towards SEGCOLOR(1)
 }
 
 // fades all pixels to black using nscale8()
 void Segment::fadeToBlackBy(uint8_t fadeBy) {
-  if (!isActive() || fadeBy == 0) return;   // optimization - no scaling to apply
-  const int cols = is2D() ? vWidth() : vLength();
-  const int rows = vHeight(); // will be 1 for 1D
-
-  for (int y = 0; y < rows; y++) for (int x = 0; x < cols; x++) {
-    if (is2D()) setPixelColorXY(x, y, color_fade(getPixelColorXY(x,y), 255-fadeBy));
-    else        setPixelColor(x, color_fade(getPixelColor(x), 255-fadeBy));
-  }
+  if (!isActive() || !_pixels || fadeBy == 0) return;   // optimization - no scaling to apply
+  color_fade_span(_pixels, virtualPixels(), 255-fadeBy);
 }
 
 /*
@@ -1126,32 +1422,14 @@ void Segment::blur(uint8_t blur_amount, bool smear) {
   if (is2D()) {
     // compatibility with 2D
     blur2D(blur_amount, blur_amount, smear); // symmetrical 2D blur
-    //box_blur(map(blur_amount,1,255,1,3), smear);
+    //box_blur(map(blur_amount,1,255,1,3), map(blur_amount,1,255,1,3));
     return;
   }
 #endif
+  if (!_pixels) return;
   uint8_t keep = smear ? 255 : 255 - blur_amount;
   uint8_t seep = blur_amount >> 1;
-  unsigned vlength = vLength();
-  uint32_t carryover = BLACK;
-  uint32_t lastnew;
-  uint32_t last;
-  uint32_t curnew = BLACK;
-  for (unsigned i = 0; i < vlength; i++) {
-    uint32_t cur = getPixelColor(i);
-    uint32_t part = color_fade(cur, seep);
-    curnew = color_fade(cur, keep);
-    if (i > 0) {
-      if (carryover) curnew = color_add(curnew, carryover);
-      uint32_t prev = color_add(lastnew, part);
-      // optimization: only set pixel if color has changed
-      if (last != prev) setPixelColor(i - 1, prev);
-    } else setPixelColor(i, curnew); // first pixel
-    lastnew = curnew;
-    last = cur; // save original value for comparison on next iteration
-    carryover = part;
-  }
-  setPixelColor(vlength - 1, curnew);
+  color_blur_span(_pixels, virtualPixels(), 1, keep, seep);
 }
 
 /*
@@ -1190,15 +1468,31 @@ uint32_t Segment::color_from_palette(uint16_t i, bool mapping, bool wrap, uint8_
     return color_fade(color, pbri, true);
   }
 
-  const int vL = vLength();
+  const unsigned vL = vLength();
   unsigned paletteIndex = i;
-  if (mapping && vL > 1) paletteIndex = (i*255)/(vL -1);
+  if (mapping && vL > 1) paletteIndex = (i < vL && _paletteStep) ? (i * _paletteStep) >> 24 : (i*255)/(vL -1);
   // paletteBlend: 0 - wrap when moving, 1 - always wrap, 2 - never wrap, 3 - none (undefined)
   if (!wrap && strip.paletteBlend != 3) paletteIndex = scale8(paletteIndex, 240); //cut off blend at palette "end"
-  CRGBW palcol = ColorFromPalette(_currentPalette, paletteIndex, pbri, (strip.paletteBlend == 3)? NOBLEND:LINEARBLEND); // NOTE: paletteBlend should be global
-  palcol.w = W(color);
+  uint32_t palcol;
+  if (usePaletteLUT && vL >= WLED_PALETTE_LUT_MIN) {
+    // long segments: blend palette once per frame and just look up colors (index is truncated to 8 bit as in ColorFromPalette())
+    if (!_paletteLUTValid) buildPaletteLUT();
+    palcol = _paletteLUT[paletteIndex & 0xFF];
+    if (pbri < 255) {
+      uint32_t scale = pbri + 1; // same rounding as ColorFromPalette(), scales red & blue and green in parallel
+      palcol = (((palcol & 0x00FF00FF) * scale >> 8) & 0x00FF00FF) | (((palcol & 0x0000FF00) * scale >> 8) & 0x0000FF00);
+    }
+  } else {
+    palcol = ColorFromPalette(_currentPalette, paletteIndex, pbri, (strip.paletteBlend == 3)? NOBLEND:LINEARBLEND); // NOTE: paletteBlend should be global
+  }
+  return (palcol & 0x00FFFFFF) | (color & 0xFF000000); // white from segment color
+}
 
-  return palcol.color32;
+// expands _currentPalette into 256 colors at full brightness
+void Segment::buildPaletteLUT() {
+  const TBlendType blendType = (strip.paletteBlend == 3) ? NOBLEND : LINEARBLEND;
+  for (unsigned i = 0; i < 256; i++) _paletteLUT[i] = ColorFromPalette(_currentPalette, i, 255, blendType);
+  _paletteLUTValid = true;
 }
 
 
@@ -1210,6 +1504,7 @@ uint32_t Segment::color_from_palette(uint16_t i, bool mapping, bool wrap, uint8_
 void WS2812FX::finalizeInit() {
   //reset segment runtimes
   restartRuntime();
+  deallocateFrame(); // length may change, frame buffer will be reallocated on next show()
 
   // for the lack of better place enumerate ledmaps here
   // if we do it in json.cpp (serializeInfo()) we are getting flashes on LEDs
@@ -1328,6 +1623,31 @@ void WS2812FX::finalizeInit() {
   deserializeMap();     // (re)load default ledmap (will also setUpMatrix() if ledmap does not exist)
 }
 
+// closes holes left in effect data arena by released data, moved blocks are reassigned to their segments
+// must not be called while an effect function is running (or previous effect state is swapped in), except by
+// allocateData() of the running effect which has just released its own data
+void WS2812FX::compactSegmentData() {
+  DataArenaLock lock;
+  if (!dataArenaHoles) return;
+  unsigned dst = 0;
+  for (unsigned ofs = 0; ofs < dataArenaTop; ) {
+    const unsigned size = arenaBlockSize(ofs);
+    if (arenaBlock(ofs)->used) {
+      if (dst != ofs) {
+        const byte *from = dataArena + ofs + sizeof(data_block_t);
+        byte *to = dataArena + dst + sizeof(data_block_t);
+        for (segment &seg : _segments) seg.relocateData(from, to);
+        memmove(dataArena + dst, dataArena + ofs, size);
+      }
+      dst += size;
+    }
+    ofs += size;
+  }
+  dataArenaTop   = dst;
+  dataArenaHoles = 0;
+  dataArenaMoves++;
+}
+
 void WS2812FX::service() {
   unsigned long nowUp = millis(); // Be aware, millis() rolls over every 49 days
   now = nowUp + timebase;
@@ -1340,7 +1660,9 @@ void WS2812FX::service() {
   }
 
   bool doShow = false;
+  uint32_t fxTime = 0, transTime = 0; // time spent in effect functions (for profiler)
 
+  compactSegmentData(); // no effect is running, safe to move effect data
   _isServicing = true;
   _segment_index = 0;
 
@@ -1357,24 +1679,23 @@ void WS2812FX::service() {
     // last condition ensures all solid segments are updated at the same time
     if (nowUp >= seg.next_time || _triggered || (doShow && seg.mode == FX_MODE_STATIC))
     {
-      doShow = true;
+      if (!seg.freeze || seg.isInTransition() || _triggered || overlayCurrent) doShow = true; // unchanged frozen segment does not need a new frame unless an overlay is drawn over it
       unsigned frameDelay = FRAMETIME;
 
       if (!seg.freeze) { //only run effect function if not frozen
-        int oldCCT = BusManager::getSegmentCCT(); // store original CCT value (actually it is not Segment based)
-        // when correctWB is true we need to correct/adjust RGB value according to desired CCT value, but it will also affect actual WW/CW ratio
-        // when cctFromRgb is true we implicitly calculate WW and CW from RGB values
-        if (cctFromRgb) BusManager::setSegmentCCT(-1);
-        else            BusManager::setSegmentCCT(seg.currentBri(true), correctWB);
+        // effects draw into segment pixel buffer, CCT, opacity and blending mode are applied when composited in show()
         // Effect blending
         // When two effects are being blended, each may have different segment data, this
         // data needs to be saved first and then restored before running previous mode.
-        // The blending will largely depend on the effect behaviour since actual output (LEDs) may be
-        // overwritten by later effect. To enable seamless blending for every effect, additional LED buffer
-        // would need to be allocated for each effect and then blended together for each pixel.
+        // Previous effect draws into its own layer (swapped in by swapSegenv()) and both layers
+        // are blended together for each pixel when the segment is composited.
         [[maybe_unused]] uint8_t tmpMode = seg.currentMode();  // this will return old mode while in transition
+        uint32_t t0 = micros();
         seg.beginDraw();                      // set up parameters for get/setPixelColor()
         frameDelay = (*_mode[seg.mode])();    // run new/current mode
+        uint32_t t1 = micros();
+        fxTime += t1 - t0;
+        PerfMonitor::recordSegment(_segment_index, t1 - t0);
 #ifndef WLED_DISABLE_MODE_BLEND
         if (modeBlending && seg.mode != tmpMode) {
           Segment::tmpsegd_t _tmpSegData;
@@ -1385,11 +1706,11 @@ void WS2812FX::service() {
           seg.restoreSegenv(_tmpSegData);     // restore mode state (will also update transitional state)
           frameDelay = min(frameDelay,d2);              // use shortest delay
           Segment::modeBlend(false);          // unset semaphore
+          transTime += micros() - t1;
         }
 #endif
         seg.call++;
         if (seg.isInTransition() && frameDelay > FRAMETIME) frameDelay = FRAMETIME; // force faster updates during transition
-        BusManager::setSegmentCCT(oldCCT); // restore old CCT for ABL adjustments
       }
 
       seg.next_time = nowUp + frameDelay;
@@ -1398,6 +1719,11 @@ void WS2812FX::service() {
   }
   _isServicing = false;
   _triggered = false;
+  if (elapsed >= FRAME_KEEPALIVE) doShow = true; // show callback (usermod overlays) and current estimate keep running
+  if (doShow) {
+    PerfMonitor::record(PERF_EFFECT, fxTime);
+    if (transTime) PerfMonitor::record(PERF_TRANSITION, transTime);
+  }
 
   #ifdef WLED_DEBUG
   if ((_targetFps != FPS_UNLIMITED) && (millis() - nowUp > _frametime)) DEBUG_PRINTF_P(PSTR("Slow effects %u/%d.\n"), (unsigned)(millis()-nowUp), (int)_frametime);
@@ -1419,13 +1745,97 @@ void IRAM_ATTR WS2812FX::setPixelColor(unsigned i, uint32_t col) {
   BusManager::setPixelColor(i, col);
 }
 
+// paints a span of strip pixels, whole span is handed to buses at once unless a ledmap needs to be applied
+void IRAM_ATTR WS2812FX::setPixelColors(unsigned i, unsigned count, const uint32_t *c) {
+  if (customMappingSize && (realtimeMode == REALTIME_MODE_INACTIVE || realtimeRespectLedMaps)) {
+    for (unsigned n = 0; n < count; n++) setPixelColor(i + n, c[n]);
+    return;
+  }
+  if (i >= _length) return;
+  BusManager::setPixelColors(i, std::min(count, _length - i), c);
+}
+
 uint32_t IRAM_ATTR WS2812FX::getPixelColor(unsigned i) const {
   i = getMappedPixelIndex(i);
   if (i >= _length) return 0;
   return BusManager::getPixelColor(i);
 }
 
+// (re)allocates strip frame buffer used for compositing segments
+bool WS2812FX::allocateFrame() {
+  const unsigned len = getLengthTotal();
+  if (_pixels && len == _pixelsLen) return true;
+  deallocateFrame();
+  if (len == 0) return false;
+  _pixels = (uint32_t*)calloc(len, sizeof(uint32_t));
+  if (!_pixels) {
+    DEBUG_PRINTLN(F("!!! Frame buffer allocation failed. !!!"));
+    errorFlag = ERR_NORAM;
+    return false;
+  }
+  _pixelCCT = (uint8_t*)malloc(len); // per pixel CCT (if allocation fails current CCT is used for all pixels)
+  _pixelsLen = len;
+  return true;
+}
+
+void WS2812FX::deallocateFrame() {
+  free(_pixels);   // free(nullptr) is a no-op
+  free(_pixelCCT);
+  _pixels = nullptr;
+  _pixelCCT = nullptr;
+  _pixelsLen = 0;
+}
+
+// blend all segment layers into frame buffer and send it to buses
+void WS2812FX::composeFrame() {
+  if (!allocateFrame()) return;
+  memset(_pixels, 0, _pixelsLen * sizeof(uint32_t));
+  if (_pixelCCT) memset(_pixelCCT, 127, _pixelsLen);
+  for (segment &seg : _segments) {
+    if (!seg.isActive()) continue;
+    seg.updateTransitionProgress(); // currentBri() & progress() are only valid for currently processed segment
+    seg.compose(_pixels, _pixelCCT, _pixelsLen);
+  }
+
+  int oldCCT = BusManager::getSegmentCCT(); // store original CCT value (actually it is not Segment based)
+  // when correctWB is true we need to correct/adjust RGB value according to desired CCT value, but it will also affect actual WW/CW ratio
+  // when cctFromRgb is true we implicitly calculate WW and CW from RGB values
+  int lastCCT = INT_MIN;
+  if (cctFromRgb) BusManager::setSegmentCCT(-1);
+  if (customMappingSize == 0) {
+    // no ledmap: push runs of pixels with equal CCT to buses as spans
+    const unsigned len = std::min(_pixelsLen, (unsigned)_length);
+    unsigned i = 0;
+    while (i < len) {
+      unsigned n = 1;
+      if (_pixelCCT && !cctFromRgb) {
+        if (_pixelCCT[i] != lastCCT) {
+          lastCCT = _pixelCCT[i];
+          BusManager::setSegmentCCT(lastCCT, correctWB);
+        }
+        while (i + n < len && _pixelCCT[i + n] == lastCCT) n++;
+      } else n = len - i;
+      BusManager::setPixelColors(i, n, _pixels + i);
+      i += n;
+    }
+  } else for (unsigned i = 0; i < _pixelsLen; i++) {
+    if (_pixelCCT && !cctFromRgb && _pixelCCT[i] != lastCCT) {
+      lastCCT = _pixelCCT[i];
+      BusManager::setSegmentCCT(lastCCT, correctWB);
+    }
+    setPixelColor(i, _pixels[i]);
+  }
+  BusManager::setSegmentCCT(oldCCT); // restore old CCT for ABL adjustments
+}
+
 void WS2812FX::show() {
+  // composite segment layers onto the strip (unless realtime data is written directly to the strip)
+  if (!realtimeMode || realtimeOverride || (realtimeMode && useMainSegmentOnly)) {
+    uint32_t t0 = micros();
+    composeFrame();
+    PerfMonitor::record(PERF_COMPOSE, micros() - t0);
+  }
+
   // avoid race condition, capture _callback value
   show_callback callback = _callback;
   if (callback) callback();
@@ -1434,7 +1844,9 @@ void WS2812FX::show() {
   // some buses send asynchronously and this method will return before
   // all of the data has been sent.
   // See https://github.com/Makuna/NeoPixelBus/wiki/ESP32-NeoMethods#neoesp32rmt-methods
+  uint32_t t0 = micros();
   BusManager::show();
+  PerfMonitor::record(PERF_SHOW, micros() - t0);
 
   size_t diff = showNow - _lastShow;
 
@@ -1451,6 +1863,23 @@ void WS2812FX::setTargetFps(unsigned fps) {
   else _frametime = MIN_FRAME_DELAY;     // unlimited mode
 }
 
+// executes a single frame of the effect assigned to segment n (draws into segment's pixel buffer only)
+// transitions are ignored and nothing is sent to LEDs, returns effect's requested frame delay
+uint16_t WS2812FX::runEffectFrame(unsigned n) {
+  if (n >= _segments.size()) return FRAMETIME;
+  Segment &seg = _segments[n];
+  seg.resetIfRequired();
+  if (!seg.isActive()) return FRAMETIME;
+  _isServicing = true;
+  _segment_index = n;
+  seg.beginDraw();
+  unsigned frameDelay = (*_mode[seg.mode < _mode.size() ? seg.mode : 0])();
+  seg.call++;
+  _segment_index = 0;
+  _isServicing = false;
+  return frameDelay;
+}
+
 void WS2812FX::setCCT(uint16_t k) {
   for (segment &seg : _segments) {
     if (seg.isActive() && seg.isSelected()) {
@@ -0,0 +1,250 @@
+#include "wled.h"
+
+/*
+ * Effect benchmark
+ * Runs every effect for a number of frames on a temporary segment of various 1D lengths and 2D sizes
+ * and measures time spent in effect function, effect data allocated and number of pixels touched.
+ * Started with /json/bench?run[&n=<frames>][&fx=<effect id>][&g=<geometry mask>][&cmp], results are
+ * returned by /json/bench (JSON) or /json/bench?csv (CSV). Benchmark runs from loop(), one effect
+ * and geometry per loop iteration; effects are not shown on LEDs while it is running.
+ * With cmp each effect is also run with palette lookup table disabled, its mean frame time is
+ * reported as base (speedup = base/mean).
+ * Geometries whose pixel buffer cannot be allocated (128x128 needs 64kB) are reported as failed (fail=1).
+ */
+#ifdef WLED_ENABLE_BENCHMARK
+
+#define BENCH_MAX_FRAMES 250
+
+// tested geometries (width x height), 2D ones are skipped if 2D support is disabled
+static const uint16_t benchGeometry[][2] PROGMEM = {
+  {60,1}, {300,1}, {1500,1}, {16,16}, {32,32}, {64,64}, {128,128}
+};
+#define BENCH_GEOMETRIES (sizeof(benchGeometry)/sizeof(benchGeometry[0]))
+
+typedef struct BenchResult {
+  uint8_t  fx;
+  uint8_t  geometry;
+  uint16_t data;    // effect data allocated (bytes)
+  uint16_t touched; // number of pixels set at least once
+  uint32_t mean;    // mean frame time (us)
+  uint32_t p99;     // 99th percentile frame time (us)
+  uint32_t max;     // slowest frame (us)
+  uint32_t base;    // mean frame time without palette lookup table (us), 0 if not compared
+  bool     failed;  // not run, pixel buffer could not be allocated
+} bench_result;
+
+static bench_result *benchResults = nullptr;
+static unsigned      benchCount   = 0;    // number of valid results
+static unsigned      benchSize    = 0;    // allocated results
+static unsigned      benchFrames  = 100;  // frames per effect and geometry
+static uint8_t       benchFx      = 0;    // effect being benchmarked
+static uint8_t       benchSingle  = 255;  // only benchmark this effect (255 = all)
+static uint8_t       benchGeom    = 0;    // geometry being benchmarked
+static uint8_t       benchMask    = 0x7F; // geometries to benchmark
+static bool          benchCompare = false; // also run without palette lookup table
+static bool          benchRunning = false;
+
+// returns true if effect only supports 2D segments (same logic as UI, flags are the 4th field of effect data)
+static bool is2DOnlyEffect(uint8_t fx) {
+  char lineBuffer[128];
+  strncpy_P(lineBuffer, strip.getModeData(fx), sizeof(lineBuffer)-1);
+  lineBuffer[sizeof(lineBuffer)-1] = '\0';
+  char *flags = strchr(lineBuffer, '@');
+  for (unsigned i = 0; flags && i < 3; i++) flags = strchr(flags+1, ';');
+  if (!flags) return false;
+  char *end = strchr(++flags, ';');
+  if (end) *end = '\0';
+  return strchr(flags, '2') && !strchr(flags, '1');
+}
+
+static bool isReservedEffect(uint8_t fx) {
+  return strncmp_P("RSVD", strip.getModeData(fx), 4) == 0;
+}
+
+static bool benchValid() {
+  return (benchMask & (1U << benchGeom)) && !isReservedEffect(benchFx);
+}
+
+// advances benchFx/benchGeom to next valid combination, returns false when finished
+static bool benchNext() {
+  do {
+    if (++benchGeom >= BENCH_GEOMETRIES) {
+      benchGeom = 0;
+      if (benchSingle < 255 || ++benchFx >= strip.getModeCount()) return false;
+    }
+  } while (!benchValid());
+  return true;
+}
+
+bool startBenchmark(unsigned frames, uint8_t fx, uint8_t mask, bool compare) {
+  if (benchRunning) return false;
+  #ifdef WLED_DISABLE_2D
+  mask &= 0x07; // 1D geometries only
+  #endif
+  if (mask == 0) return false;
+  free(benchResults);
+  benchCount   = 0;
+  benchSingle  = fx < strip.getModeCount() ? fx : 255;
+  benchSize    = (benchSingle < 255 ? 1 : strip.getModeCount()) * BENCH_GEOMETRIES;
+  benchResults = (bench_result*)malloc(benchSize * sizeof(bench_result));
+  if (!benchResults) {
+    benchSize = 0;
+    DEBUG_PRINTLN(F("Benchmark: not enough memory."));
+    return false;
+  }
+  benchFrames = constrain(frames, 1, BENCH_MAX_FRAMES);
+  benchFx     = benchSingle < 255 ? benchSingle : 0;
+  benchGeom   = 0;
+  benchMask   = mask;
+  benchCompare = compare;
+  if (!benchValid() && !benchNext()) return false;
+  benchRunning = true;
+  strip.suspend();
+  DEBUG_PRINTF_P(PSTR("Benchmark started: %u frames.\n"), benchFrames);
+  return true;
+}
+
+// runs effect on segment for benchFrames frames starting at strip.now, returns total time spent in effect (us)
+static uint64_t benchRun(unsigned id, uint32_t *times, uint8_t *touched, unsigned &maxData) {
+  Segment &seg = strip.getSegment(id);
+  const unsigned w = seg.width();
+  const unsigned h = seg.height();
+  const unsigned long oldNow = strip.now;
+  uint64_t total = 0;
+  for (unsigned f = 0; f < benchFrames; f++) {
+    strip.now = oldNow + f * FRAMETIME; // simulated time, as if effect was running at target FPS
+    unsigned long start = micros();
+    strip.runEffectFrame(id);
+    times[f] = micros() - start;
+    total += times[f];
+    if (seg.dataSize() > maxData) maxData = seg.dataSize();
+    // pixel scan is not timed
+    for (unsigned i = 0; touched && i < w*h; i++) {
+      #ifndef WLED_DISABLE_2D
+      uint32_t c = h > 1 ? seg.getPixelColorXY(i % w, i / w) : seg.getPixelColor(i);
+      #else
+      uint32_t c = seg.getPixelColor(i);
+      #endif
+      if (c) touched[i >> 3] |= 1 << (i & 7);
+    }
+    if ((f & 0x0F) == 0) yield(); // keep watchdog happy
+  }
+  strip.now = oldNow;
+  return total;
+}
+
+// runs one effect on one geometry
+static void benchStep() {
+  const unsigned w = pgm_read_word(&benchGeometry[benchGeom][0]);
+  const unsigned h = pgm_read_word(&benchGeometry[benchGeom][1]);
+  if (h == 1 && is2DOnlyEffect(benchFx)) return; // 2D effect on 1D segment makes no sense
+  if (strip.getSegmentsNum() >= strip.getMaxSegments()) return;
+
+  uint32_t *times   = (uint32_t*)malloc(benchFrames * sizeof(uint32_t));
+  uint8_t  *touched = (uint8_t*)calloc((w*h + 7) / 8, 1);
+  if (!times || !touched) {
+    free(times);
+    free(touched);
+    return;
+  }
+
+  // append temporary segment, it will be removed by purgeSegments() when done
+  const unsigned id = strip.getSegmentsNum();
+  const unsigned mainSeg = strip.getMainSegmentId();
+  const bool oldModeBlending = modeBlending;
+  const bool oldPaletteFade = strip.paletteFade;
+  const bool oldStateChanged = stateChanged;
+  const byte oldErrorFlag = errorFlag;
+  modeBlending = false; // no transitions on temporary segment
+  strip.compactSegmentData(); // strip.service() is suspended and does not compact effect data
+  strip.paletteFade = false;
+  strip.appendSegment(Segment(0, w, 0, h));
+  Segment &seg = strip.getSegment(id);
+  seg.setMode(benchFx, true);
+
+  unsigned maxData = 0;
+  uint64_t base = 0;
+  uint64_t total = 0;
+  // without pixel buffer effect would draw nothing and its timing would be meaningless
+  const bool failed = !seg.allocatePixels();
+  if (failed) {
+    errorFlag = oldErrorFlag; // benchmark geometry does not affect normal operation
+    DEBUG_PRINTF_P(PSTR("Benchmark: no pixel buffer for %ux%u.\n"), w, h);
+  } else {
+    if (benchCompare) {
+      // same frames without palette lookup table, then restart effect for the measured run
+      Segment::usePaletteLUT = false;
+      base = benchRun(id, times, nullptr, maxData);
+      Segment::usePaletteLUT = true;
+      seg.markForReset().resetIfRequired();
+    }
+    total = benchRun(id, times, touched, maxData);
+    std::sort(times, times + benchFrames);
+  }
+
+  if (benchCount < benchSize) {
+    bench_result &r = benchResults[benchCount++];
+    r.fx       = benchFx;
+    r.geometry = benchGeom;
+    r.data     = min(maxData, 65535U);
+    r.touched  = 0;
+    for (unsigned i = 0; i < (w*h + 7) / 8; i++) r.touched += __builtin_popcount(touched[i]);
+    r.mean     = total / benchFrames;
+    r.p99      = failed ? 0 : times[(benchFrames * 99 + 99) / 100 - 1];
+    r.max      = failed ? 0 : times[benchFrames - 1];
+    r.base     = base / benchFrames;
+    r.failed   = failed;
+  }
+
+  seg.stop = 0; // mark temporary segment inactive so it is purged
+  strip.purgeSegments();
+  strip.setMainSegmentId(mainSeg);
+  modeBlending = oldModeBlending;
+  strip.paletteFade = oldPaletteFade;
+  stateChanged = oldStateChanged;
+  free(times);
+  free(touched);
+}
+
+// called from loop()
+void handleBenchmark() {
+  if (!benchRunning) return;
+  benchStep();
+  if (!benchNext()) {
+    benchRunning = false;
+    strip.resume();
+    strip.trigger();
+    DEBUG_PRINTF_P(PSTR("Benchmark finished: %u results.\n"), benchCount);
+  }
+}
+
+// /json/bench: starts benchmark or returns results (JSON or CSV)
+void serveBenchmark(AsyncWebServerRequest* request) {
+  if (request->hasParam(F("run"))) {
+    unsigned frames = request->hasParam(F("n"))  ? request->getParam(F("n"))->value().toInt()  : 100;
+    unsigned fx     = request->hasParam(F("fx")) ? request->getParam(F("fx"))->value().toInt() : 255;
+    unsigned mask   = request->hasParam(F("g"))  ? request->getParam(F("g"))->value().toInt()  : 0x7F;
+    if (!startBenchmark(frames, fx, mask, request->hasParam(F("cmp")))) { // already running or not enough memory
+      serveJsonError(request, 503, ERR_NOBUF);
+      return;
+    }
+  }
+
+  const bool csv = request->hasParam(F("csv"));
+  AsyncResponseStream *response = request->beginResponseStream(csv ? FPSTR(CONTENT_TYPE_PLAIN) : FPSTR(CONTENT_TYPE_JSON));
+  response->addHeader(F("Cache-Control"), F("no-store"));
+  if (csv) response->print(F("fx,w,h,mean_us,p99_us,max_us,base_us,data,px,fail\n"));
+  else     response->printf_P(PSTR("{\"run\":%s,\"n\":%u,\"fx\":["), benchRunning ? "true" : "false", benchFrames);
+  for (unsigned i = 0; i < benchCount; i++) {
+    const bench_result &r = benchResults[i];
+    const unsigned w = pgm_read_word(&benchGeometry[r.geometry][0]);
+    const unsigned h = pgm_read_word(&benchGeometry[r.geometry][1]);
+    if (csv) response->printf_P(PSTR("%u,%u,%u,%u,%u,%u,%u,%u,%u,%u\n"), r.fx, w, h, (unsigned)r.mean, (unsigned)r.p99, (unsigned)r.max, (unsigned)r.base, r.data, r.touched, (unsigned)r.failed);
+    else     response->printf_P(PSTR("%s{\"id\":%u,\"w\":%u,\"h\":%u,\"mean\":%u,\"p99\":%u,\"max\":%u,\"base\":%u,\"data\":%u,\"px\":%u,\"fail\":%u}"),
+                                i ? "," : "", r.fx, w, h, (unsigned)r.mean, (unsigned)r.p99, (unsigned)r.max, (unsigned)r.base, r.data, r.touched, (unsigned)r.failed);
+  }
+  if (!csv) response->print(F("]}"));
+  request->send(response);
+}
+
+#endif
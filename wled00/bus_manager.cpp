@@ -20,6 +20,7 @@
 #include "pin_manager.h"
 #include "bus_wrapper.h"
 #include "bus_manager.h"
+#include "perf.h"
 
 extern bool cctICused;
 
@@ -27,7 +28,7 @@ extern bool cctICused;
 uint32_t colorBalanceFromKelvin(uint16_t kelvin, uint32_t rgb);
 
 //udp.cpp
-uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, byte *buffer, uint8_t bri=255, bool isRGBW=false);
+uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, byte *buffer, uint8_t bri=255, bool isRGBW=false, uint8_t clients=1);
 
 // enable additional debug output
 #if defined(WLED_DEBUG_HOST)
@@ -78,6 +79,21 @@ uint8_t IRAM_ATTR ColorOrderMap::getPixelColorOrder(uint16_t pix, uint8_t defaul
 }
 
 
+// returns true if bus output needs to be refreshed: pixel data or brightness changed since last shown frame,
+// bus requires continuous refresh or keepalive interval expired
+bool Bus::hasChanged(unsigned long now) {
+  bool changed = _needsRefresh || mustRefresh() || _bri != _lastBri || (_keepAlive && now - _lastShow >= _keepAlive);
+  if (_hash != BUS_HASH_SEED) { // pixels were written
+    changed |= _hash != _lastHash;
+    _lastHash = _hash;
+  }
+  if (changed) {
+    _lastBri = _bri;
+    _lastShow = now;
+  }
+  return changed;
+}
+
 void Bus::calculateCCT(uint32_t c, uint8_t &ww, uint8_t &cw) {
   unsigned cct = 0; //0 - full warm white, 255 - full cold white
   unsigned w = W(c);
@@ -128,6 +144,7 @@ BusDigital::BusDigital(BusConfig &bc, uint8_t nr, const ColorOrderMap &com)
 , _milliAmpsPerLed(bc.milliAmpsPerLed)
 , _milliAmpsMax(bc.milliAmpsMax)
 , _colorOrderMap(com)
+, _milliAmpsTotal(0)
 {
   if (!isDigital(bc.type) || !bc.count) return;
   if (!PinManager::allocatePin(bc.pins[0], true, PinOwner::BusDigital)) return;
@@ -184,11 +201,15 @@ uint8_t BusDigital::estimateCurrentAndLimitBri() {
   }
 
   uint32_t busPowerSum = 0;
-  for (unsigned i = 0; i < getLength(); i++) {  //sum up the usage of each LED
+  if (isFrameCovered() && _type != TYPE_WS2812_1CH_X3 && _type != TYPE_WS2812_2CH_X3) { // multi-zone ICs share pixels
+    busPowerSum = _powerSum; // accumulated in setPixelColor() while frame was written
+  } else for (unsigned i = 0; i < getLength(); i++) {  //sum up the usage of each LED (partial update or multiple writes per pixel)
     uint32_t c = getPixelColor(i); // always returns original or restored color without brightness scaling
     byte r = R(c), g = G(c), b = B(c), w = W(c);
 
-    if (useWackyWS2815PowerModel) { //ignore white component on WS2815 power calculation
+    if (!hasRGB()) { //white-only bus: getPixelColor() returns W in all channels
+      busPowerSum += w;
+    } else if (useWackyWS2815PowerModel) { //ignore white component on WS2815 power calculation
       busPowerSum += (max(max(r,g),b)) * 3;
     } else {
       busPowerSum += (r + g + b + w);
@@ -220,7 +241,9 @@ void BusDigital::show() {
   if (!_valid) return;
 
   uint8_t cctWW = 0, cctCW = 0;
+  uint32_t t0 = micros();
   unsigned newBri = estimateCurrentAndLimitBri();  // will fill _milliAmpsTotal
+  PerfMonitor::record(PERF_ABL, micros() - t0);
   if (newBri < _bri) PolyBus::setBrightness(_busPtr, _iType, newBri); // limit brightness to stay within current limits
 
   if (_data) {
@@ -300,6 +323,11 @@ void IRAM_ATTR BusDigital::setPixelColor(unsigned pix, uint32_t c) {
   if (!_valid) return;
   if (hasWhite()) c = autoWhiteCalc(c);
   if (Bus::_cct >= 1900) c = colorBalanceFromKelvin(Bus::_cct, c); //color correction from CCT
+  // accumulate power estimate so ABL does not need to read back all pixels (same model as estimateCurrentAndLimitBri())
+  // only count channels the bus actually outputs
+  if (!hasRGB())                    _powerSum += W(c);
+  else if (_milliAmpsPerLed == 255) _powerSum += max(max(R(c),G(c)),B(c)) * 3;
+  else                              _powerSum += R(c) + G(c) + B(c) + (hasWhite() ? W(c) : 0);
   if (_data) {
     size_t offset = pix * getNumberOfChannels();
     uint8_t* dataptr = _data + offset;
@@ -721,7 +749,9 @@ BusNetwork::BusNetwork(BusConfig &bc)
   _hasWhite = hasWhite(bc.type);
   _hasCCT = false;
   _UDPchannels = _hasWhite + 3;
+  _keepAlive = BUS_NETWORK_KEEPALIVE; // receivers may time out if nothing is sent
   _client = IPAddress(bc.pins[0],bc.pins[1],bc.pins[2],bc.pins[3]);
+  _clients = (bc.pins[4] > 0 && bc.pins[4] < 255) ? min(bc.pins[4], (uint8_t)BUS_NETWORK_MAX_CLIENTS) : 1; // unset in older configs
   _valid = (allocateData(_len * _UDPchannels) != nullptr);
   DEBUG_PRINTF_P(PSTR("%successfully inited virtual strip with type %u and IP %u.%u.%u.%u\n"), _valid?"S":"Uns", bc.type, bc.pins[0], bc.pins[1], bc.pins[2], bc.pins[3]);
 }
@@ -746,19 +776,23 @@ uint32_t BusNetwork::getPixelColor(unsigned pix) const {
 void BusNetwork::show() {
   if (!_valid || !canShow()) return;
   _broadcastLock = true;
-  realtimeBroadcast(_UDPtype, _client, _len, _data, _bri, hasWhite());
+  realtimeBroadcast(_UDPtype, _client, _len, _data, _bri, hasWhite(), _clients);
   _broadcastLock = false;
 }
 
 uint8_t BusNetwork::getPins(uint8_t* pinArray) const {
-  if (pinArray) for (unsigned i = 0; i < 4; i++) pinArray[i] = _client[i];
-  return 4;
+  if (pinArray) {
+    for (unsigned i = 0; i < 4; i++) pinArray[i] = _client[i];
+    pinArray[4] = _clients;
+  }
+  return 5;
 }
 
 // credit @willmmiles & @netmindz https://github.com/Aircoookie/WLED/pull/4056
 std::vector<LEDType> BusNetwork::getLEDTypes() {
   return {
     {TYPE_NET_DDP_RGB,     "N",     PSTR("DDP RGB (network)")},      // should be "NNNN" to determine 4 "pin" fields
+    {TYPE_NET_E131_RGB,    "N",     PSTR("E1.31 RGB (network)")},
     {TYPE_NET_ARTNET_RGB,  "N",     PSTR("Art-Net RGB (network)")},
     {TYPE_NET_DDP_RGBW,    "N",     PSTR("DDP RGBW (network)")},
     {TYPE_NET_ARTNET_RGBW, "N",     PSTR("Art-Net RGBW (network)")},
@@ -777,9 +811,52 @@ void BusNetwork::cleanup() {
 }
 
 
+BusMemory::BusMemory(BusConfig &bc)
+: Bus(bc.type, bc.start, bc.autoWhite, bc.count, bc.reversed)
+{
+  _hasRgb = true;
+  _hasWhite = true;
+  _hasCCT = false;
+  _valid = (allocateData(_len * sizeof(uint32_t)) != nullptr);
+  DEBUG_PRINTF_P(PSTR("%successfully inited simulated bus with %u LEDs\n"), _valid?"S":"Uns", _len);
+}
+
+void BusMemory::setPixelColor(unsigned pix, uint32_t c) {
+  if (!_valid || pix >= _len) return;
+  if (_reversed) pix = _len - pix - 1;
+  reinterpret_cast<uint32_t*>(_data)[pix] = c;
+}
+
+void BusMemory::setPixelColors(unsigned pix, unsigned count, const uint32_t *c) {
+  if (!_valid || pix >= _len) return;
+  if (count > _len - pix) count = _len - pix;
+  if (_reversed) for (unsigned i = 0; i < count; i++) setPixelColor(pix + i, c[i]);
+  else memcpy(_data + pix * sizeof(uint32_t), c, count * sizeof(uint32_t));
+}
+
+uint32_t BusMemory::getPixelColor(unsigned pix) const {
+  if (!_valid || pix >= _len) return 0;
+  if (_reversed) pix = _len - pix - 1;
+  return reinterpret_cast<const uint32_t*>(_data)[pix];
+}
+
+std::vector<LEDType> BusMemory::getLEDTypes() {
+  return {
+    {TYPE_VIRTUAL_MEMORY, "V",     PSTR("Simulated (no output)")}, // config field is unused
+  };
+}
+
+void BusMemory::cleanup() {
+  _type = I_NONE;
+  _valid = false;
+  freeData();
+}
+
+
 //utility to get the approx. memory usage of a given BusConfig
 uint32_t BusManager::memUsage(BusConfig &bc) {
   if (Bus::isOnOff(bc.type) || Bus::isPWM(bc.type)) return OUTPUT_MAX_PINS;
+  if (bc.type == TYPE_VIRTUAL_MEMORY) return bc.count * sizeof(uint32_t);
 
   unsigned len = bc.count + bc.skipAmount;
   unsigned channels = Bus::getNumberOfChannels(bc.type);
@@ -805,7 +882,9 @@ uint32_t BusManager::memUsage(unsigned maxChannels, unsigned maxCount, unsigned
 
 int BusManager::add(BusConfig &bc) {
   if (getNumBusses() - getNumVirtualBusses() >= WLED_MAX_BUSSES) return -1;
-  if (Bus::isVirtual(bc.type)) {
+  if (bc.type == TYPE_VIRTUAL_MEMORY) {
+    busses[numBusses] = new BusMemory(bc);
+  } else if (Bus::isVirtual(bc.type)) {
     busses[numBusses] = new BusNetwork(bc);
   } else if (Bus::isDigital(bc.type)) {
     busses[numBusses] = new BusDigital(bc, numBusses, colorOrderMap);
@@ -814,7 +893,40 @@ int BusManager::add(BusConfig &bc) {
   } else {
     busses[numBusses] = new BusPwm(bc);
   }
-  return numBusses++;
+  numBusses++;
+  buildPixelBusMap();
+  return numBusses - 1;
+}
+
+// creates lookup table (one byte per pixel) to find bus for each pixel without iterating over all buses
+// overlapping buses (pixel sent to multiple outputs) are not supported by the table, linear search is used instead
+void BusManager::buildPixelBusMap() {
+  free(_pixelBus); // free(nullptr) is a no-op
+  _pixelBus = nullptr;
+  _pixelBusLen = 0;
+  unsigned len = 0;
+  for (unsigned i = 0; i < numBusses; i++) {
+    unsigned end = busses[i]->getStart() + busses[i]->getLength();
+    if (end > len) len = end;
+  }
+  if (len == 0) return;
+  _pixelBus = (uint8_t*)malloc(len);
+  if (!_pixelBus) return;
+  memset(_pixelBus, 0xFF, len); // no bus
+  for (unsigned i = 0; i < numBusses; i++) {
+    unsigned start = busses[i]->getStart();
+    unsigned end   = start + busses[i]->getLength();
+    for (unsigned pix = start; pix < end; pix++) {
+      if (_pixelBus[pix] != 0xFF) { // overlapping buses
+        DEBUG_PRINTLN(F("Overlapping buses, pixel lookup table disabled."));
+        free(_pixelBus);
+        _pixelBus = nullptr;
+        return;
+      }
+      _pixelBus[pix] = i;
+    }
+  }
+  _pixelBusLen = len;
 }
 
 // credit @willmmiles
@@ -837,6 +949,7 @@ String BusManager::getLEDTypesJSONString() {
   json += LEDTypesToJson(BusOnOff::getLEDTypes());
   json += LEDTypesToJson(BusPwm::getLEDTypes());
   json += LEDTypesToJson(BusNetwork::getLEDTypes());
+  json += LEDTypesToJson(BusMemory::getLEDTypes());
   //json += LEDTypesToJson(BusVirtual::getLEDTypes());
   json.setCharAt(json.length()-1, ']'); // replace last comma with bracket
   return json;
@@ -854,6 +967,7 @@ void BusManager::removeAll() {
   while (!canAllShow()) yield();
   for (unsigned i = 0; i < numBusses; i++) delete busses[i];
   numBusses = 0;
+  buildPixelBusMap(); // releases lookup table
   _parallelOutputs = 1;
   PolyBus::setParallelI2S1Output(false);
 }
@@ -930,11 +1044,18 @@ void BusManager::off() {
 }
 
 void BusManager::show() {
+  const unsigned long now = millis();
   _milliAmpsUsed = 0;
   for (unsigned i = 0; i < numBusses; i++) {
-    busses[i]->show();
+    if (busses[i]->hasChanged(now)) busses[i]->show(); // skip transmission of unchanged frames (current estimate is retained)
+    busses[i]->resetFrame();
     _milliAmpsUsed += busses[i]->getUsedCurrent();
   }
+  if (now - _lastSample >= BUS_CURRENT_INTERVAL) {
+    _milliAmpsHistory[_historyIndex] = currentMilliamps();
+    _historyIndex = (_historyIndex + 1) % BUS_CURRENT_HISTORY;
+    _lastSample = now;
+  }
 }
 
 void BusManager::setStatusPixel(uint32_t c) {
@@ -944,13 +1065,44 @@ void BusManager::setStatusPixel(uint32_t c) {
 }
 
 void IRAM_ATTR BusManager::setPixelColor(unsigned pix, uint32_t c) {
+  if (_pixelBus) {
+    Bus *bus = getPixelBus(pix);
+    if (bus) {
+      bus->hashPixel(pix, c);
+      bus->pixelWritten(); // pixel may be written more than once, ABL reads frame back
+      bus->setPixelColor(pix - bus->getStart(), c);
+    }
+    return;
+  }
   for (unsigned i = 0; i < numBusses; i++) {
     unsigned bstart = busses[i]->getStart();
     if (pix < bstart || pix >= bstart + busses[i]->getLength()) continue;
+    busses[i]->hashPixel(pix, c);
+    busses[i]->pixelWritten();
     busses[i]->setPixelColor(pix - bstart, c);
   }
 }
 
+// sets a span of consecutive pixels, each bus receives its part of the span in a single call
+void IRAM_ATTR BusManager::setPixelColors(unsigned start, unsigned count, const uint32_t *c) {
+  if (!_pixelBus) {
+    for (unsigned i = 0; i < count; i++) setPixelColor(start + i, c[i]);
+    return;
+  }
+  const unsigned end = start + count;
+  unsigned pix = start;
+  while (pix < end) {
+    Bus *bus = getPixelBus(pix);
+    if (!bus) { pix++; continue; } // pixel not covered by any bus
+    const unsigned bstart = bus->getStart();
+    const unsigned n = std::min(end, bstart + bus->getLength()) - pix;
+    for (unsigned i = 0; i < n; i++) bus->hashPixel(pix + i, c[pix - start + i]);
+    bus->spanWritten(pix - bstart, n);
+    bus->setPixelColors(pix - bstart, n, c + (pix - start));
+    pix += n;
+  }
+}
+
 void BusManager::setBrightness(uint8_t b) {
   for (unsigned i = 0; i < numBusses; i++) {
     busses[i]->setBrightness(b);
@@ -967,6 +1119,10 @@ void BusManager::setSegmentCCT(int16_t cct, bool allowWBCorrection) {
 }
 
 uint32_t BusManager::getPixelColor(unsigned pix) {
+  if (_pixelBus) {
+    const Bus *bus = getPixelBus(pix);
+    return bus ? bus->getPixelColor(pix - bus->getStart()) : 0;
+  }
   for (unsigned i = 0; i < numBusses; i++) {
     unsigned bstart = busses[i]->getStart();
     if (!busses[i]->containsPixel(pix)) continue;
@@ -1001,11 +1157,14 @@ int16_t Bus::_cct = -1;
 uint8_t Bus::_cctBlend = 0;
 uint8_t Bus::_gAWM = 255;
 
-uint16_t BusDigital::_milliAmpsTotal = 0;
-
 uint8_t       BusManager::numBusses = 0;
 Bus*          BusManager::busses[WLED_MAX_BUSSES+WLED_MIN_VIRTUAL_BUSSES];
 ColorOrderMap BusManager::colorOrderMap = {};
 uint16_t      BusManager::_milliAmpsUsed = 0;
+uint16_t      BusManager::_milliAmpsHistory[BUS_CURRENT_HISTORY] = {0};
+uint8_t       BusManager::_historyIndex = 0;
+unsigned long BusManager::_lastSample = 0;
 uint16_t      BusManager::_milliAmpsMax = ABL_MILLIAMPS_DEFAULT;
+uint8_t*      BusManager::_pixelBus = nullptr;
+uint16_t      BusManager::_pixelBusLen = 0;
 uint8_t       BusManager::_parallelOutputs = 1;
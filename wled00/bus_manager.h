@@ -23,6 +23,13 @@ uint16_t approximateKelvinFromRGB(uint32_t rgb);
 #define IC_INDEX_WS2812_2CH_3X(i)  ((i)*2/3)
 #define WS2812_2CH_3X_SPANS_2_ICS(i) ((i)&0x01)    // every other LED zone is on two different ICs
 
+#define BUS_HASH_SEED           2166136261U // FNV offset basis, checksum of a frame with no pixels written
+#define BUS_NETWORK_KEEPALIVE   1000        // ms, unchanged network bus data is re-sent at this interval
+#define BUS_SPAN_BROKEN         UINT32_MAX  // pixels of current frame were not written as consecutive spans
+#define BUS_NETWORK_MAX_CLIENTS 16          // max receivers (consecutive IP addresses) a network bus fans out to
+#define BUS_CURRENT_HISTORY     30          // number of LED current samples kept
+#define BUS_CURRENT_INTERVAL    2000        // ms between LED current samples
+
 struct BusConfig; // forward declaration
 
 // Defines an LED Strip and its color ordering.
@@ -74,6 +81,13 @@ class Bus {
     , _valid(false)
     , _needsRefresh(refresh)
     , _data(nullptr) // keep data access consistent across all types of buses
+    , _hash(BUS_HASH_SEED)
+    , _lastHash(0)
+    , _powerSum(0)
+    , _spanNext(0)
+    , _lastBri(0)
+    , _keepAlive(0)
+    , _lastShow(0)
     {
       _autoWhiteMode = Bus::hasWhite(type) ? aw : RGBW_MODE_MANUAL_ONLY;
     };
@@ -85,6 +99,7 @@ class Bus {
     virtual bool     canShow() const                          { return true; }
     virtual void     setStatusPixel(uint32_t c)                {}
     virtual void     setPixelColor(unsigned pix, uint32_t c) = 0;
+    virtual void     setPixelColors(unsigned pix, unsigned count, const uint32_t *c) { for (unsigned i = 0; i < count; i++) setPixelColor(pix + i, c[i]); } // span of pixels (buses may override with faster bulk copy)
     virtual void     setBrightness(uint8_t b)                  { _bri = b; };
     virtual void     setColorOrder(uint8_t co)                 {}
     virtual uint32_t getPixelColor(unsigned pix) const         { return 0; }
@@ -117,6 +132,14 @@ class Bus {
     inline  bool     isOk() const                              { return _valid; }
     inline  bool     isReversed() const                        { return _reversed; }
     inline  bool     isOffRefreshRequired() const              { return _needsRefresh; }
+    // checksum of pixel data (and CCT used to convert it) written to the bus in current frame, used to skip unchanged frames
+    inline  void     hashPixel(unsigned pix, uint32_t c)       { _hash = ((_hash ^ c) * 16777619U) ^ (pix + ((uint32_t)_cct << 16)); }
+    bool             hasChanged(unsigned long now);
+    inline  void     resetFrame()                              { _hash = BUS_HASH_SEED; _powerSum = 0; _spanNext = 0; } // start accumulating next frame
+    // frame is covered if it was written as consecutive spans starting at first pixel, so each pixel exactly once
+    inline  void     spanWritten(unsigned pix, unsigned n)     { _spanNext = (pix == _spanNext) ? _spanNext + n : BUS_SPAN_BROKEN; }
+    inline  void     pixelWritten()                            { _spanNext = BUS_SPAN_BROKEN; }
+    inline  bool     isFrameCovered() const                    { return _spanNext == _len; }
     inline  bool     containsPixel(uint16_t pix) const         { return pix >= _start && pix < _start + _len; }
 
     static inline std::vector<LEDType> getLEDTypes()           { return {{TYPE_NONE, "", PSTR("None")}}; } // not used. just for reference for derived classes
@@ -177,6 +200,13 @@ class Bus {
     //} __attribute__ ((packed));
     uint8_t  _autoWhiteMode;
     uint8_t  *_data;
+    uint32_t _hash;       // checksum of pixels written since last show()
+    uint32_t _lastHash;   // checksum of last shown frame
+    uint32_t _powerSum;   // sum of channel values written in current frame (for ABL)
+    uint32_t _spanNext;   // first pixel after consecutive spans written in current frame (BUS_SPAN_BROKEN if written otherwise)
+    uint8_t  _lastBri;    // brightness of last shown frame
+    uint16_t _keepAlive;  // (ms) re-send unchanged frame after this time (0 = never)
+    unsigned long _lastShow;
     // global Auto White Calculation override
     static uint8_t _gAWM;
     // _cct has the following menaings (see calculateCCT() & BusManager::setSegmentCCT()):
@@ -230,8 +260,7 @@ class BusDigital : public Bus {
     uint16_t _milliAmpsMax;
     void * _busPtr;
     const ColorOrderMap &_colorOrderMap;
-
-    static uint16_t _milliAmpsTotal; // is overwitten/recalculated on each show()
+    uint16_t _milliAmpsTotal; // is overwitten/recalculated on each show()
 
     inline uint32_t restoreColorLossy(uint32_t c, uint8_t restoreBri) const {
       if (restoreBri < 255) {
@@ -312,10 +341,30 @@ class BusNetwork : public Bus {
     IPAddress _client;
     uint8_t   _UDPtype;
     uint8_t   _UDPchannels;
+    uint8_t   _clients;       // number of receivers at consecutive IP addresses
     bool      _broadcastLock;
 };
 
 
+// memory backed bus without any output, used for measuring effect performance without LEDs attached
+class BusMemory : public Bus {
+  public:
+    BusMemory(BusConfig &bc);
+    ~BusMemory() { cleanup(); }
+
+    void setPixelColor(unsigned pix, uint32_t c) override;
+    void setPixelColors(unsigned pix, unsigned count, const uint32_t *c) override;
+    uint32_t getPixelColor(unsigned pix) const override;
+    uint8_t  getPins(uint8_t* pinArray = nullptr) const override { return 0; }
+    void show() override {}
+    void cleanup();
+
+    inline const uint32_t* getPixels() const { return reinterpret_cast<const uint32_t*>(_data); }
+
+    static std::vector<LEDType> getLEDTypes();
+};
+
+
 //temporary struct for passing bus configuration to bus
 struct BusConfig {
   uint8_t type;
@@ -382,6 +431,7 @@ class BusManager {
     static uint32_t memUsage(BusConfig &bc);
     static uint32_t memUsage(unsigned channels, unsigned count, unsigned buses = 1);
     static uint16_t currentMilliamps() { return _milliAmpsUsed + MA_FOR_ESP; }
+    static uint16_t getCurrentHistory(unsigned i) { return _milliAmpsHistory[(_historyIndex + i) % BUS_CURRENT_HISTORY]; } // oldest first
     static uint16_t ablMilliampsMax()  { return _milliAmpsMax; }
 
     static int add(BusConfig &bc);
@@ -397,6 +447,7 @@ class BusManager {
     static bool canAllShow();
     static void setStatusPixel(uint32_t c);
     [[gnu::hot]] static void setPixelColor(unsigned pix, uint32_t c);
+    [[gnu::hot]] static void setPixelColors(unsigned start, unsigned count, const uint32_t *c); // set a span of consecutive pixels
     static void setBrightness(uint8_t b);
     // for setSegmentCCT(), cct can only be in [-1,255] range; allowWBCorrection will convert it to K
     // WARNING: setSegmentCCT() is a misleading name!!! much better would be setGlobalCCT() or just setCCT()
@@ -419,8 +470,18 @@ class BusManager {
     static Bus* busses[WLED_MAX_BUSSES+WLED_MIN_VIRTUAL_BUSSES];
     static ColorOrderMap colorOrderMap;
     static uint16_t _milliAmpsUsed;
+    static uint16_t _milliAmpsHistory[BUS_CURRENT_HISTORY]; // total LED current sampled every BUS_CURRENT_INTERVAL
+    static uint8_t  _historyIndex;
+    static unsigned long _lastSample;
     static uint16_t _milliAmpsMax;
     static uint8_t _parallelOutputs;
+    static uint8_t *_pixelBus;      // bus index for each pixel (O(1) lookup), nullptr if buses overlap or allocation failed
+    static uint16_t _pixelBusLen;
+
+    static void buildPixelBusMap(); // (re)builds pixel to bus lookup table
+    static inline Bus* getPixelBus(unsigned pix) { // only valid if _pixelBus is allocated
+      return (pix < _pixelBusLen && _pixelBus[pix] < numBusses) ? busses[_pixelBus[pix]] : nullptr;
+    }
 
     #ifdef ESP32_DATA_IDLE_HIGH
     static void    esp32RMTInvertIdle() ;
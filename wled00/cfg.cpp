@@ -118,6 +118,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   Bus::setCCTBlend(strip.cctBlending);
   strip.setTargetFps(hw_led["fps"]); //NOP if 0, default 42 FPS
   CJSON(useGlobalLedBuffer, hw_led[F("ld")]);
+  CJSON(netBusPacing, hw_led[F("npace")]);
 
   #ifndef WLED_DISABLE_2D
   // 2D Matrix Settings
@@ -387,6 +388,9 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   }
 
   CJSON(serialBaud, hw[F("baud")]);
+  uint16_t loopBudget = PerfMonitor::getBudget();
+  CJSON(loopBudget, hw[F("lbudget")]);
+  PerfMonitor::setBudget(loopBudget);
   if (serialBaud < 96 || serialBaud > 15000) serialBaud = 1152;
   updateBaudRate(serialBaud *100);
 
@@ -485,6 +489,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   CJSON(receiveGroups, if_sync_recv["grp"]);
   CJSON(receiveSegmentOptions, if_sync_recv["seg"]);
   CJSON(receiveSegmentBounds, if_sync_recv["sb"]);
+  CJSON(clockSyncEnabled, if_sync_recv["clk"]);
 
   JsonObject if_sync_send = if_sync[F("send")];
   CJSON(sendNotifications, if_sync_send["en"]);
@@ -496,6 +501,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   CJSON(syncGroups, if_sync_send["grp"]);
   if (if_sync_send[F("twice")]) udpNumRetries = 1; // import setting from 0.13 and earlier
   CJSON(udpNumRetries, if_sync_send["ret"]);
+  CJSON(syncProtocolV2, if_sync_send["v2"]);
 
   JsonObject if_nodes = interfaces["nodes"];
   CJSON(nodeListEnabled, if_nodes[F("list")]);
@@ -823,6 +829,7 @@ void serializeConfig() {
   hw_led["fps"] = strip.getTargetFps();
   hw_led[F("rgbwm")] = Bus::getGlobalAWMode(); // global auto white mode override
   hw_led[F("ld")] = useGlobalLedBuffer;
+  hw_led[F("npace")] = netBusPacing;
 
   #ifndef WLED_DISABLE_2D
   // 2D Matrix Settings
@@ -913,6 +920,7 @@ void serializeConfig() {
   hw_relay[F("odrain")] = rlyOpenDrain;
 
   hw[F("baud")] = serialBaud;
+  hw[F("lbudget")] = PerfMonitor::getBudget();
 
   JsonObject hw_if = hw.createNestedObject(F("if"));
   JsonArray hw_if_i2c = hw_if.createNestedArray("i2c-pin");
@@ -973,6 +981,7 @@ void serializeConfig() {
   if_sync_recv["grp"] = receiveGroups;
   if_sync_recv["seg"] = receiveSegmentOptions;
   if_sync_recv["sb"]  = receiveSegmentBounds;
+  if_sync_recv["clk"] = clockSyncEnabled;
 
   JsonObject if_sync_send = if_sync.createNestedObject(F("send"));
   if_sync_send["en"] = sendNotifications;
@@ -982,6 +991,7 @@ void serializeConfig() {
   if_sync_send["hue"] = notifyHue;
   if_sync_send["grp"] = syncGroups;
   if_sync_send["ret"] = udpNumRetries;
+  if_sync_send["v2"] = syncProtocolV2;
 
   JsonObject if_nodes = interfaces.createNestedObject("nodes");
   if_nodes[F("list")] = nodeListEnabled;
@@ -83,6 +83,117 @@ uint32_t color_fade(uint32_t c1, uint8_t amount, bool video)
   return scaledcolor;
 }
 
+/*
+ * bulk operations on spans of pixels (contiguous rows of segment's virtual pixel buffer)
+ * results are identical to applying the single color functions above pixel by pixel
+ */
+
+// same as color_fade(c, amount) for each pixel, red & blue and white & green are scaled in parallel
+void color_fade_span(uint32_t *px, unsigned len, uint8_t amount)
+{
+  if (amount == 255) return;
+  if (amount == 0) { memset(px, 0, len * sizeof(uint32_t)); return; }
+  const uint32_t scale = amount + 1;
+  for (unsigned i = 0; i < len; i++) {
+    const uint32_t c = px[i];
+    px[i] = ((((c & 0x00FF00FF) * scale) >> 8) & 0x00FF00FF) | ((((c & 0xFF00FF00) >> 8) * scale) & 0xFF00FF00);
+  }
+}
+
+// fades each pixel towards target color (higher rate = quicker fade), used by Segment::fade_out()
+void color_fade_toward_span(uint32_t *px, unsigned len, uint32_t target, uint8_t rate)
+{
+  // per channel step for each possible difference, calculated once instead of a float multiply per channel & pixel
+  // if fade isn't complete step is at least 1 (fixes rounding issues)
+  const float mappedRate = 1.0f / (float((255-rate) >> 1) + 1.1f);
+  uint8_t step[256];
+  step[0] = 0;
+  for (unsigned d = 1; d < 256; d++) step[d] = int(float(d) * mappedRate) + 1;
+
+  for (unsigned i = 0; i < len; i++) {
+    const uint32_t c = px[i];
+    if (c == target) continue; // already at target color
+    uint32_t faded = 0;
+    for (unsigned shift = 0; shift < 32; shift += 8) {
+      const unsigned c1 = (c >> shift) & 0xFF;
+      const unsigned c2 = (target >> shift) & 0xFF;
+      faded |= (c2 > c1 ? c1 + step[c2 - c1] : c1 - step[c1 - c2]) << shift;
+    }
+    px[i] = faded;
+  }
+}
+
+// FastLED style blur of len pixels spaced stride apart (stride = row width for columns), used by Segment::blur() & blur2D()
+void color_blur_span(uint32_t *px, unsigned len, unsigned stride, uint8_t keep, uint8_t seep)
+{
+  if (len == 0) return;
+  uint32_t carryover = BLACK;
+  uint32_t lastnew = BLACK;
+  uint32_t last = BLACK;
+  uint32_t curnew = BLACK;
+  for (unsigned i = 0; i < len; i++) {
+    uint32_t cur = px[i * stride];
+    uint32_t part = color_fade(cur, seep);
+    curnew = color_fade(cur, keep);
+    if (i > 0) {
+      if (carryover) curnew = color_add(curnew, carryover);
+      uint32_t prev = color_add(lastnew, part);
+      if (last != prev) px[(i - 1) * stride] = prev; // first pixel keeps its faded value if unchanged (as with setPixelColor())
+    } else px[0] = curnew; // first pixel
+    lastnew = curnew;
+    last = cur; // save original value for comparison on next iteration
+    carryover = part;
+  }
+  px[(len - 1) * stride] = curnew; // last pixel
+}
+
+// ceil(2^18/n): sum/n == (sum*boxBlurDiv[n])>>18 for sums of up to 17 8 bit values
+static const uint32_t boxBlurDiv[BOX_BLUR_MAX_RADIUS*2+2] = {
+  0, 262144, 131072, 87382, 65536, 52429, 43691, 37450, 32768, 29128, 26215, 23832, 21846, 20165, 18725, 17477, 16384, 15421
+};
+
+// box blur of len pixels spaced stride apart using sliding window sums, cost per pixel does not depend on radius
+// window is clipped at span ends, tmp must hold len pixels (original values are copied there so blur can be done in place)
+void color_box_blur_span(uint32_t *px, unsigned len, unsigned stride, unsigned radius, uint32_t *tmp)
+{
+  if (len < 2 || radius == 0) return;
+  if (radius > BOX_BLUR_MAX_RADIUS) radius = BOX_BLUR_MAX_RADIUS;
+  for (unsigned i = 0; i < len; i++) tmp[i] = px[i * stride];
+  // channel sums are kept in 16 bit lanes: red & blue and white & green
+  uint32_t rb = 0, wg = 0;
+  unsigned count = 0;
+  for (unsigned i = 0; i < radius && i < len; i++, count++) {
+    rb += tmp[i] & 0x00FF00FF;
+    wg += (tmp[i] >> 8) & 0x00FF00FF;
+  }
+  for (unsigned i = 0; i < len; i++) {
+    if (i + radius < len) { // pixel entering window
+      const uint32_t c = tmp[i + radius];
+      rb += c & 0x00FF00FF;
+      wg += (c >> 8) & 0x00FF00FF;
+      count++;
+    }
+    if (i > radius) {       // pixel leaving window
+      const uint32_t c = tmp[i - radius - 1];
+      rb -= c & 0x00FF00FF;
+      wg -= (c >> 8) & 0x00FF00FF;
+      count--;
+    }
+    const uint32_t div = boxBlurDiv[count];
+    px[i * stride] = RGBW32(((rb >> 16) * div) >> 18, ((wg & 0xFFFF) * div) >> 18, ((rb & 0xFFFF) * div) >> 18, ((wg >> 16) * div) >> 18);
+  }
+}
+
+// moves pixels delta positions towards start of span (delta < 0 towards end), vacated pixels are left unchanged if not wrapping
+void color_shift_span(uint32_t *px, unsigned len, int delta, bool wrap)
+{
+  const unsigned absDelta = abs(delta);
+  if (absDelta == 0 || absDelta >= len) return;
+  if (wrap)           std::rotate(px, px + (delta > 0 ? absDelta : len - absDelta), px + len);
+  else if (delta > 0) memmove(px, px + absDelta, (len - absDelta) * sizeof(uint32_t));
+  else                memmove(px + absDelta, px, (len - absDelta) * sizeof(uint32_t));
+}
+
 // 1:1 replacement of fastled function optimized for ESP, slightly faster, more accurate and uses less flash (~ -200bytes)
 uint32_t ColorFromPaletteWLED(const CRGBPalette16& pal, unsigned index, uint8_t brightness, TBlendType blendType)
 {
@@ -4,10 +4,56 @@
 #define MAX_4_CH_LEDS_PER_UNIVERSE 128
 #define MAX_CHANNELS_PER_UNIVERSE 512
 
+#define E131_FRAME_TIMEOUT 30   // ms, incomplete frame is shown after this time
+#define E131_SYNC_TIMEOUT  4000 // ms, synchronized mode ends if no sync packet is received in this time (Art-Net spec)
+
 /*
  * E1.31 handler
  */
 
+// Frame assembly for multi-universe setups: universes are written to the strip as they arrive but the frame
+// is only shown once all universes are received, a sync packet (E1.31 universe sync / ArtSync) arrives or
+// E131_FRAME_TIMEOUT expires. This prevents showing frames with universes from different source frames.
+static uint32_t      e131FrameUniverses = 0; // bitmask of universes received for current frame
+static unsigned      e131FrameExpected = 1;  // number of universes making a complete frame
+static unsigned long e131FrameStart = 0;     // when first universe of current frame was received
+static unsigned long e131LastSync = 0;       // when last sync packet was received
+static uint16_t      e131SyncAddress = 0;    // E1.31 synchronization universe announced in data packets
+
+static inline bool e131SyncActive() {
+  return e131LastSync && millis() - e131LastSync < E131_SYNC_TIMEOUT;
+}
+
+// number of universes needed to fill all LEDs in current DMX mode
+static unsigned e131ExpectedUniverses() {
+  if (DMXMode != DMX_MODE_MULTIPLE_RGB && DMXMode != DMX_MODE_MULTIPLE_DRGB && DMXMode != DMX_MODE_MULTIPLE_RGBW) return 1;
+  const bool is4Chan = (DMXMode == DMX_MODE_MULTIPLE_RGBW);
+  const unsigned dmxChannelsPerLed = is4Chan ? 4 : 3;
+  const unsigned ledsPerUniverse = is4Chan ? MAX_4_CH_LEDS_PER_UNIVERSE : MAX_3_CH_LEDS_PER_UNIVERSE;
+  const unsigned dmxLenOffset = (DMXAddress == 0) ? 0 : 1;
+  const unsigned dimmerOffset = (DMXMode == DMX_MODE_MULTIPLE_DRGB) ? 1 : 0;
+  const unsigned ledsInFirstUniverse = (((MAX_CHANNELS_PER_UNIVERSE - DMXAddress) + dmxLenOffset) - dimmerOffset) / dmxChannelsPerLed;
+  const unsigned totalLen = strip.getLengthTotal();
+  unsigned n = 1;
+  if (totalLen > ledsInFirstUniverse) n += (totalLen - ledsInFirstUniverse + ledsPerUniverse - 1) / ledsPerUniverse;
+  return min(n, (unsigned)E131_MAX_UNIVERSE_COUNT);
+}
+
+// marks assembled frame ready to be shown (by handleNotifications())
+static void e131ShowFrame() {
+  if (!e131FrameUniverses) return;
+  unsigned received = __builtin_popcount(e131FrameUniverses);
+  if (received < e131FrameExpected) e131UniversesDropped += e131FrameExpected - received;
+  e131FrameUniverses = 0;
+  e131FramesShown++;
+  e131NewData = true;
+}
+
+// called from handleNotifications(): shows incomplete frame if missing universes did not arrive in time
+void handleE131Frame() {
+  if (e131FrameUniverses && millis() - e131FrameStart > E131_FRAME_TIMEOUT) e131ShowFrame();
+}
+
 //DDP protocol support, called by handleE131Packet
 //handles RGB data only
 void handleDDPPacket(e131_packet_t* p) {
@@ -40,9 +86,7 @@ void handleDDPPacket(e131_packet_t* p) {
 
   if (!realtimeOverride || (realtimeMode && useMainSegmentOnly)) {
     if (useMainSegmentOnly) strip.getMainSegment().beginDraw();
-    for (unsigned i = start; i < stop; i++, c += ddpChannelsPerLed) {
-      setRealtimePixel(i, data[c], data[c+1], data[c+2], ddpChannelsPerLed >3 ? data[c+3] : 0);
-    }
+    if (stop > start) setRealtimePixels(start, data + c, stop - start, ddpChannelsPerLed);
   }
 
   bool push = p->flags & DDP_PUSH_FLAG;
@@ -67,12 +111,24 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
       handleArtnetPollReply(clientIP);
       return;
     }
+    if (p->art_opcode == ARTNET_OPCODE_OPSYNC) {
+      e131LastSync = millis();
+      e131ShowFrame();
+      return;
+    }
     uni = p->art_universe;
     dmxChannels = htons(p->art_length);
     e131_data = p->art_data;
     seq = p->art_sequence_number;
     mde = REALTIME_MODE_ARTNET;
   } else if (protocol == P_E131) {
+    if (htonl(p->root_vector) == 8) { // synchronization packet (VECTOR_ROOT_E131_EXTENDED)
+      if (htons(p->sync_universe) == e131SyncAddress) {
+        e131LastSync = millis();
+        e131ShowFrame();
+      }
+      return;
+    }
     // Ignore PREVIEW data (E1.31: 6.2.6)
     if ((p->options & 0x80) != 0) return;
     dmxChannels = htons(p->property_value_count) - 1;
@@ -107,12 +163,24 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
 
   unsigned previousUniverses = uni - e131Universe;
 
-  if (e131SkipOutOfSequence)
-    if (seq < e131LastSequenceNumber[previousUniverses] && seq > 20 && e131LastSequenceNumber[previousUniverses] < 250){
+  if (seq < e131LastSequenceNumber[previousUniverses] && seq > 20 && e131LastSequenceNumber[previousUniverses] < 250) {
+    e131PacketsLate++;
+    if (e131SkipOutOfSequence) {
       DEBUG_PRINTF_P(PSTR("skipping E1.31 frame (last seq=%d, current seq=%d, universe=%d)\n"), e131LastSequenceNumber[previousUniverses], seq, uni);
       return;
     }
+  }
+
+  // frame assembly: universe repeated before frame was complete
+  if (e131FrameUniverses & (1UL << previousUniverses)) {
+    if (seq != 0 && seq == e131LastSequenceNumber[previousUniverses]) { // same packet received twice
+      e131PacketsDuplicate++;
+      return;
+    }
+    if (!e131SyncActive()) e131ShowFrame(); // new source frame started, show what we have of the previous one
+  }
   e131LastSequenceNumber[previousUniverses] = seq;
+  if (protocol == P_E131) e131SyncAddress = htons(p->sync_address);
 
   // update status info
   realtimeIP = clientIP;
@@ -312,17 +380,7 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
         }
 
         if (useMainSegmentOnly) strip.getMainSegment().beginDraw();
-        if (!is4Chan) {
-          for (unsigned i = previousLeds; i < ledsTotal; i++) {
-            setRealtimePixel(i, e131_data[dmxOffset], e131_data[dmxOffset+1], e131_data[dmxOffset+2], 0);
-            dmxOffset+=3;
-          }
-        } else {
-          for (unsigned i = previousLeds; i < ledsTotal; i++) {
-            setRealtimePixel(i, e131_data[dmxOffset], e131_data[dmxOffset+1], e131_data[dmxOffset+2], e131_data[dmxOffset+3]);
-            dmxOffset+=4;
-          }
-        }
+        if (ledsTotal > previousLeds) setRealtimePixels(previousLeds, e131_data + dmxOffset, ledsTotal - previousLeds, is4Chan ? 4 : 3);
         break;
       }
     default:
@@ -331,7 +389,13 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
       break;
   }
 
-  e131NewData = true;
+  if (!e131FrameUniverses) {
+    e131FrameStart = millis();
+    e131FrameExpected = e131ExpectedUniverses();
+  }
+  e131FrameUniverses |= 1UL << previousUniverses;
+  // synchronized sources tell when to show, otherwise show as soon as all universes are received
+  if (!e131SyncActive() && __builtin_popcount(e131FrameUniverses) >= e131FrameExpected) e131ShowFrame();
 }
 
 void handleArtnetPollReply(IPAddress ipAddress) {
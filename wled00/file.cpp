@@ -32,6 +32,24 @@ static volatile size_t knownLargestSpace = MAX_SPACE;
 
 static File f; // don't export to other cpp files
 
+/*
+ * Preset index: position of each "<id>": key in presets.json, so presets can be read and written without
+ * scanning the whole file. Index is built with a single pass over the file when first needed and kept up to date
+ * by writeObjectToFile(). If the file is changed by other means (upload, /edit) the file size or the key at the
+ * indexed position will not match and the index is rebuilt.
+ */
+#define PRESET_INDEX_SIZE 256
+static uint32_t *presetIndex = nullptr;  // key position for each preset id, 0 if preset does not exist
+static size_t    presetIndexFileSize = 0; // presets.json size index was built for (0 = invalid)
+
+void invalidatePresetIndex() {
+  presetIndexFileSize = 0;
+}
+
+static bool isPresetsFile(const char *fileName) {
+  return strcmp_P(fileName, getPresetsFileName()) == 0;
+}
+
 //wrapper to find out how long closing takes
 void closeFile() {
   #ifdef WLED_DEBUG_FS
@@ -161,6 +179,85 @@ static bool bufferedFindObjectEnd() {
   return false;
 }
 
+//builds preset index with a single pass over the file (strings are skipped so braces in preset names are ok)
+static bool buildPresetIndex() {
+  #ifdef WLED_DEBUG_FS
+    DEBUGFS_PRINTLN(F("Build preset index"));
+    uint32_t s = millis();
+  #endif
+  if (!presetIndex) presetIndex = (uint32_t*)malloc(PRESET_INDEX_SIZE * sizeof(uint32_t));
+  if (!presetIndex || !f) return false;
+  memset(presetIndex, 0, PRESET_INDEX_SIZE * sizeof(uint32_t));
+
+  unsigned depth = 0;
+  bool inString = false, escape = false, isKey = false, expectColon = false;
+  uint32_t keyPos = 0;
+  unsigned keyId = 0, keyLen = 0;
+  byte buf[FS_BUFSIZE];
+  f.seek(0);
+  size_t bufPos = 0;
+  while (bufPos < f.size()) {
+    size_t bufsize = f.read(buf, FS_BUFSIZE);
+    if (!bufsize) break;
+    for (size_t i = 0; i < bufsize; i++) {
+      const char c = buf[i];
+      if (expectColon) {
+        expectColon = false;
+        if (c == ':' && keyId < PRESET_INDEX_SIZE) presetIndex[keyId] = keyPos;
+      }
+      if (inString) {
+        if (escape)         escape = false;
+        else if (c == '\\') escape = true;
+        else if (c == '"') {
+          inString = false;
+          expectColon = isKey && keyLen > 0;
+        } else if (isKey) {
+          if (c >= '0' && c <= '9' && keyLen < 4) { keyId = keyId * 10 + (c - '0'); keyLen++; }
+          else isKey = false; // not a preset id
+        }
+        continue;
+      }
+      if      (c == '{') depth++;
+      else if (c == '}') depth--;
+      else if (c == '"') {
+        inString = true;
+        isKey = (depth == 1); // root level strings are keys
+        keyPos = bufPos + i;
+        keyId = keyLen = 0;
+      }
+    }
+    bufPos += bufsize;
+  }
+  presetIndexFileSize = f.size();
+  DEBUGFS_PRINTF("Index built, took %d ms\n", millis() - s);
+  return true;
+}
+
+//positions file after key, using preset index if id >= 0
+static bool findObjectKey(const char *key, int id) {
+  if (id < 0 || id >= PRESET_INDEX_SIZE) return bufferedFind(key);
+  if (!f || !f.size()) return false;
+  for (unsigned attempt = 0; attempt < 2; attempt++) {
+    if (presetIndexFileSize != f.size() && !buildPresetIndex()) return bufferedFind(key); // no memory for index
+    if (!presetIndex[id]) return false; // preset does not exist
+    // verify key is at indexed position (file may have been edited without changing its size)
+    const size_t keyLen = strlen(key);
+    char buf[12];
+    f.seek(presetIndex[id]);
+    if (keyLen < sizeof(buf) && f.read((uint8_t*)buf, keyLen) == keyLen && strncmp(buf, key, keyLen) == 0) return true; // file is positioned after key
+    DEBUGFS_PRINTLN(F("Preset index stale."));
+    invalidatePresetIndex();
+  }
+  return false;
+}
+
+//updates preset index after key was written at pos (pos 0 removes preset from index)
+static void updatePresetIndex(int id, uint32_t pos) {
+  if (id < 0 || id >= PRESET_INDEX_SIZE || !presetIndex || !presetIndexFileSize) return;
+  presetIndex[id] = pos;
+  presetIndexFileSize = max(f.size(), (size_t)f.position()); // file may have grown
+}
+
 //fills n bytes from current file pos with ' ' characters
 static void writeSpace(size_t l)
 {
@@ -176,7 +273,7 @@ static void writeSpace(size_t l)
   if (knownLargestSpace < l) knownLargestSpace = l;
 }
 
-bool appendObjectToFile(const char* key, JsonDocument* content, uint32_t s, uint32_t contentLen = 0)
+bool appendObjectToFile(const char* key, JsonDocument* content, uint32_t s, uint32_t contentLen = 0, int id = -1)
 {
   #ifdef WLED_DEBUG_FS
     DEBUGFS_PRINTLN(F("Append"));
@@ -189,6 +286,7 @@ bool appendObjectToFile(const char* key, JsonDocument* content, uint32_t s, uint
     char init[10];
     strcpy_P(init, PSTR("{\"0\":{}}"));
     f.print(init);
+    invalidatePresetIndex();
   }
 
   if (content->isNull()) {
@@ -201,8 +299,10 @@ bool appendObjectToFile(const char* key, JsonDocument* content, uint32_t s, uint
   DEBUGFS_PRINTF("CLen %d\n", contentLen);
   if (bufferedFindSpace(contentLen + strlen(key) + 1)) {
     if (f.position() > 2) f.write(','); //add comma if not first object
+    uint32_t keyPos = f.position();
     f.print(key);
     serializeJson(*content, f);
+    updatePresetIndex(id, keyPos);
     DEBUGFS_PRINTF("Inserted, took %d ms (total %d)", millis() - s1, millis() - s);
     doCloseFile = true;
     return true;
@@ -242,27 +342,23 @@ bool appendObjectToFile(const char* key, JsonDocument* content, uint32_t s, uint
   } else { //file content is not valid JSON object
     f.seek(0, SeekSet);
     f.print('{'); //start JSON
+    invalidatePresetIndex();
   }
 
+  uint32_t keyPos = f.position();
   f.print(key);
 
   //Append object
   serializeJson(*content, f);
   f.write('}');
+  updatePresetIndex(id, keyPos);
 
   doCloseFile = true;
   DEBUGFS_PRINTF("Appended, took %d ms (total %d)", millis() - s1, millis() - s);
   return true;
 }
 
-bool writeObjectToFileUsingId(const char* file, uint16_t id, JsonDocument* content)
-{
-  char objKey[10];
-  sprintf(objKey, "\"%d\":", id);
-  return writeObjectToFile(file, objKey, content);
-}
-
-bool writeObjectToFile(const char* file, const char* key, JsonDocument* content)
+static bool writeObject(const char* file, const char* key, JsonDocument* content, int id)
 {
   uint32_t s = 0; //timing
   #ifdef WLED_DEBUG_FS
@@ -278,10 +374,13 @@ bool writeObjectToFile(const char* file, const char* key, JsonDocument* content)
     DEBUGFS_PRINTLN(F("Failed to open!"));
     return false;
   }
+  if (isPresetsFile(fileName)) {
+    if (id < 0) invalidatePresetIndex(); // written without id, positions may change
+  } else id = -1;
 
-  if (!bufferedFind(key)) //key does not exist in file
+  if (!findObjectKey(key, id)) //key does not exist in file
   {
-    return appendObjectToFile(key, content, s);
+    return appendObjectToFile(key, content, s, 0, id);
   }
 
   //an object with this key already exists, replace or delete it
@@ -317,7 +416,8 @@ bool writeObjectToFile(const char* file, const char* key, JsonDocument* content)
     if (pos > 3) pos--; //also delete leading comma if not first object
     f.seek(pos);
     writeSpace(pos2 - pos);
-    if (contentLen) return appendObjectToFile(key, content, s, contentLen);
+    updatePresetIndex(id, 0);
+    if (contentLen) return appendObjectToFile(key, content, s, contentLen, id);
   }
 
   doCloseFile = true;
@@ -325,15 +425,19 @@ bool writeObjectToFile(const char* file, const char* key, JsonDocument* content)
   return true;
 }
 
-bool readObjectFromFileUsingId(const char* file, uint16_t id, JsonDocument* dest)
+bool writeObjectToFileUsingId(const char* file, uint16_t id, JsonDocument* content)
 {
   char objKey[10];
   sprintf(objKey, "\"%d\":", id);
-  return readObjectFromFile(file, objKey, dest);
+  return writeObject(file, objKey, content, id);
 }
 
-//if the key is a nullptr, deserialize entire object
-bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest)
+bool writeObjectToFile(const char* file, const char* key, JsonDocument* content)
+{
+  return writeObject(file, key, content, -1);
+}
+
+static bool readObject(const char* file, const char* key, JsonDocument* dest, int id)
 {
   if (doCloseFile) closeFile();
   #ifdef WLED_DEBUG_FS
@@ -343,8 +447,9 @@ bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest)
   char fileName[129]; strncpy_P(fileName, file, 128); fileName[128] = 0; //use PROGMEM safe copy as FS.open() does not
   f = WLED_FS.open(fileName, "r");
   if (!f) return false;
+  if (!isPresetsFile(fileName)) id = -1;
 
-  if (key != nullptr && !bufferedFind(key)) //key does not exist in file
+  if (key != nullptr && !findObjectKey(key, id)) //key does not exist in file
   {
     f.close();
     dest->clear();
@@ -359,6 +464,19 @@ bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest)
   return true;
 }
 
+bool readObjectFromFileUsingId(const char* file, uint16_t id, JsonDocument* dest)
+{
+  char objKey[10];
+  sprintf(objKey, "\"%d\":", id);
+  return readObject(file, objKey, dest, id);
+}
+
+//if the key is a nullptr, deserialize entire object
+bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest)
+{
+  return readObject(file, key, dest, -1);
+}
+
 void updateFSInfo() {
   #ifdef ARDUINO_ARCH_ESP32
     #if WLED_FS == LITTLEFS || ESP_IDF_VERSION_MAJOR >= 4
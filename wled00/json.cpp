@@ -10,6 +10,7 @@
 #define JSON_PATH_FXDATA     6
 #define JSON_PATH_NETWORKS   7
 #define JSON_PATH_EFFECTS    8
+#define JSON_PATH_PERF       9
 
 /*
  * JSON API (De)serialization
@@ -130,6 +131,8 @@ bool deserializeSegment(JsonObject elem, byte it, byte presetId)
   seg.freeze = getBoolVal(elem["frz"], seg.freeze);
 
   seg.setCCT(elem["cct"] | seg.cct);
+  uint8_t blendMode = elem[F("bm")] | seg.blendMode;
+  seg.blendMode = constrain(blendMode, SEG_BLEND_NORMAL, SEG_BLEND_MAX);
 
   JsonArray colarr = elem["col"];
   if (!colarr.isNull())
@@ -213,7 +216,7 @@ bool deserializeSegment(JsonObject elem, byte it, byte presetId)
   seg.reverse_y  = getBoolVal(elem["rY"]   , seg.reverse_y);
   seg.mirror_y   = getBoolVal(elem["mY"]   , seg.mirror_y);
   seg.transpose  = getBoolVal(elem[F("tp")], seg.transpose);
-  if (seg.is2D() && seg.map1D2D == M12_pArc && (reverse != seg.reverse || reverse_y != seg.reverse_y || mirror != seg.mirror || mirror_y != seg.mirror_y)) seg.fill(BLACK); // clear entire segment (in case of Arc 1D to 2D expansion)
+  if (seg.is2D() && seg.map1D2D == M12_pArc && (reverse != seg.reverse || reverse_y != seg.reverse_y || mirror != seg.mirror || mirror_y != seg.mirror_y)) { seg.beginDraw(); seg.fill(BLACK); } // clear entire segment (in case of Arc 1D to 2D expansion)
   #endif
 
   byte fx = seg.mode;
@@ -251,6 +254,7 @@ bool deserializeSegment(JsonObject elem, byte it, byte presetId)
     strip.setTransition(0);
     strip.setBrightness(scaledBri(bri), true);
 
+    seg.beginDraw(); // set up parameters for get/setPixelColor()
     // freeze and init to black
     if (!seg.freeze) {
       seg.freeze = true;
@@ -515,6 +519,7 @@ void serializeSegment(JsonObject& root, Segment& seg, byte id, bool forPreset, b
   byte segbri    = seg.opacity;
   root["bri"]    = (segbri) ? segbri : 255;
   root["cct"]    = seg.cct;
+  root[F("bm")]  = seg.blendMode;
   root[F("set")] = seg.set;
 
   if (seg.name != nullptr) root["n"] = reinterpret_cast<const char *>(seg.name); //not good practice, but decreases required JSON buffer
@@ -631,6 +636,10 @@ void serializeInfo(JsonObject root)
   leds[F("pwr")] = BusManager::currentMilliamps();
   leds["fps"] = strip.getFps();
   leds[F("maxpwr")] = BusManager::currentMilliamps()>0 ? BusManager::ablMilliampsMax() : 0;
+  JsonArray busPwr = leds.createNestedArray(F("pwrs")); // estimated current of each bus (mA)
+  for (unsigned i = 0; i < BusManager::getNumBusses(); i++) busPwr.add(BusManager::getBus(i)->getUsedCurrent());
+  JsonArray pwrHist = leds.createNestedArray(F("pwrh")); // total current history (oldest first)
+  for (unsigned i = 0; i < BUS_CURRENT_HISTORY; i++) pwrHist.add(BusManager::getCurrentHistory(i));
   leds[F("maxseg")] = strip.getMaxSegments();
   //leds[F("actseg")] = strip.getActiveSegmentsNum();
   //leds[F("seglock")] = false; //might be used in the future to prevent modifications to segment config
@@ -692,6 +701,28 @@ void serializeInfo(JsonObject root)
 
   root[F("lip")] = realtimeIP[0] == 0 ? "" : realtimeIP.toString();
 
+  JsonObject jsonLock = root.createNestedObject(F("jlock"));
+  jsonLock[F("req")]  = jsonLockRequests;
+  jsonLock[F("cont")] = jsonLockContended;
+  jsonLock[F("fail")] = jsonLockFailed;
+  jsonLock[F("wait")] = jsonLockWaitTotal;
+  jsonLock[F("maxw")] = jsonLockWaitMax;
+  jsonLock[F("pool")] = jsonPoolUsed;
+
+  JsonObject e131 = root.createNestedObject(F("e131"));
+  e131[F("frames")] = e131FramesShown;
+  e131[F("late")]   = e131PacketsLate;
+  e131[F("dup")]    = e131PacketsDuplicate;
+  e131[F("drop")]   = e131UniversesDropped;
+
+  serializeLoopWatchdog(root.createNestedObject(F("lwd")));
+
+  JsonObject csync = root.createNestedObject(F("csync"));
+  csync[F("lock")] = clockSyncLocked;
+  csync[F("ofs")]  = clockSyncOffset;
+  csync[F("jit")]  = clockSyncJitter;
+  csync[F("rtt")]  = clockSyncRTT;
+
   #ifdef WLED_ENABLE_WEBSOCKETS
   root[F("ws")] = ws.count();
   #else
@@ -763,6 +794,12 @@ void serializeInfo(JsonObject root)
   #if defined(ARDUINO_ARCH_ESP32)
   if (psramSafe && psramFound()) root[F("psram")] = ESP.getFreePsram();
   #endif
+  JsonObject fxmem = root.createNestedObject(F("fxmem")); // effect data arena
+  fxmem[F("size")] = MAX_SEGMENT_DATA;
+  fxmem[F("used")] = Segment::getUsedSegmentData();
+  fxmem[F("peak")] = Segment::getPeakSegmentData();
+  fxmem[F("frag")] = Segment::getSegmentDataFragmentation();
+  fxmem[F("cmp")]  = Segment::getSegmentDataMoves();
   root[F("uptime")] = millis()/1000 + rolloverMillis*4294967;
 
   char time[32];
@@ -966,59 +1003,209 @@ void serializeNodes(JsonObject root)
   }
 }
 
-// deserializes mode data string into JsonArray
-void serializeModeData(JsonArray fxdata)
+// frame time profiler statistics (all times in us)
+void serializePerf(JsonObject root)
 {
-  char lineBuffer[256];
-  for (size_t i = 0; i < strip.getModeCount(); i++) {
-    strncpy_P(lineBuffer, strip.getModeData(i), sizeof(lineBuffer)/sizeof(char)-1);
-    lineBuffer[sizeof(lineBuffer)/sizeof(char)-1] = '\0'; // terminate string
-    if (lineBuffer[0] != 0) {
-      char* dataPtr = strchr(lineBuffer,'@');
-      if (dataPtr) fxdata.add(dataPtr+1);
-      else         fxdata.add("");
-    }
+  root[F("fps")] = strip.getFps();
+  root[F("hb")]  = 1 << PERF_BUCKET_SHIFT; // upper bound of first histogram bucket, each next bucket doubles
+  JsonObject stages = root.createNestedObject(F("stages"));
+  for (unsigned i = 0; i < PERF_STAGES; i++) {
+    const perf_stat &s = PerfMonitor::getStat(i);
+    JsonObject stage = stages.createNestedObject(FPSTR(PerfMonitor::getStageName(i)));
+    stage[F("avg")]  = s.avg16 >> 4;
+    stage[F("last")] = s.last;
+    stage[F("max")]  = s.max;
+    stage["n"]       = s.count;
+    JsonArray hist = stage.createNestedArray(F("hist"));
+    for (unsigned b = 0; b < PERF_BUCKETS; b++) hist.add(s.hist[b]);
+  }
+  JsonArray segs = root.createNestedArray("seg");
+  for (unsigned i = 0; i < strip.getSegmentsNum() && i < PERF_MAX_SEGMENTS; i++) {
+    if (!strip.getSegment(i).isActive()) continue;
+    JsonObject seg = segs.createNestedObject();
+    seg["id"]     = i;
+    seg["fx"]     = strip.getSegment(i).mode;
+    seg[F("avg")] = PerfMonitor::getSegmentAvg(i);
+    seg[F("max")] = PerfMonitor::getSegmentMax(i);
   }
 }
 
-// deserializes mode names string into JsonArray
-// also removes effect data extensions (@...) from deserialised names
-void serializeModeNames(JsonArray arr)
+// loop watchdog: loops over budget, which stage was slowest in them and loop stage timing (times in us)
+void serializeLoopWatchdog(JsonObject root)
 {
-  char lineBuffer[256];
-  for (size_t i = 0; i < strip.getModeCount(); i++) {
-    strncpy_P(lineBuffer, strip.getModeData(i), sizeof(lineBuffer)/sizeof(char)-1);
-    lineBuffer[sizeof(lineBuffer)/sizeof(char)-1] = '\0'; // terminate string
-    if (lineBuffer[0] != 0) {
-      char* dataPtr = strchr(lineBuffer,'@');
-      if (dataPtr) *dataPtr = 0; // terminate mode data after name
-      arr.add(lineBuffer);
-    }
+  root[F("budget")] = PerfMonitor::getBudget(); // ms
+  root[F("ovr")]    = PerfMonitor::getOverruns();
+  if (PerfMonitor::getOverruns()) {
+    JsonObject last = root.createNestedObject(F("last"));
+    last[F("stage")] = FPSTR(PerfMonitor::getStageName(PerfMonitor::getLastOffender()));
+    last[F("us")]    = PerfMonitor::getLastOffenderTime();
+    last[F("loop")]  = PerfMonitor::getLastOverrun();
+  }
+  JsonObject blame  = root.createNestedObject(F("blame"));
+  JsonObject stages = root.createNestedObject(F("stages")); // [avg, max]
+  for (unsigned i = 0; i < PERF_STAGES; i++) {
+    if (!((PERF_LOOP_STAGES >> i) & 1)) continue;
+    if (PerfMonitor::getBlame(i)) blame[FPSTR(PerfMonitor::getStageName(i))] = PerfMonitor::getBlame(i);
+    const perf_stat &s = PerfMonitor::getStat(i);
+    JsonArray stage = stages.createNestedArray(FPSTR(PerfMonitor::getStageName(i)));
+    stage.add(s.avg16 >> 4);
+    stage.add(s.max);
   }
 }
 
 // Global buffer locking response helper class (to make sure lock is released when AsyncJsonResponse is destroyed)
 class LockedJsonResponse: public AsyncJsonResponse {
+  JsonDocument *_doc;
   bool _holding_lock;
   public:
-  // WARNING: constructor assumes requestJSONBufferLock() was successfully acquired externally/prior to constructing the instance
+  // WARNING: constructor assumes requestJSONBuffer() was successfully acquired externally/prior to constructing the instance
   // Not a good practice with C++. Unfortunately AsyncJsonResponse only has 2 constructors - for dynamic buffer or existing buffer,
   // with existing buffer it clears its content during construction
   // if the lock was not acquired (using JSONBufferGuard class) previous implementation still cleared existing buffer
-  inline LockedJsonResponse(JsonDocument* doc, bool isArray) : AsyncJsonResponse(doc, isArray), _holding_lock(true) {};
+  inline LockedJsonResponse(JsonDocument* doc, bool isArray) : AsyncJsonResponse(doc, isArray), _doc(doc), _holding_lock(true) {};
+
+  // response is serialized, global buffer may be used by others while it is sent (from pool document or copy)
+  inline void detach() { _doc = detachJSONBuffer(_doc); }
 
-  virtual size_t _fillBuffer(uint8_t *buf, size_t maxLen) { 
-    size_t result = AsyncJsonResponse::_fillBuffer(buf, maxLen);
+  // serialize from _doc (AsyncJsonResponse root may point to global buffer that has been detached)
+  virtual size_t _fillBuffer(uint8_t *buf, size_t maxLen) {
+    ChunkPrint dest(buf, _sentLength, maxLen);
+    serializeJson(*_doc, dest);
+    size_t result = maxLen;
     // Release lock as soon as we're done filling content
     if (((result + _sentLength) >= (_contentLength)) && _holding_lock) {
-      releaseJSONBufferLock();
+      releaseJSONBuffer(_doc);
       _holding_lock = false;
     }
     return result;
   }
 
   // destructor will remove JSON buffer lock when response is destroyed in AsyncWebServer
-  virtual ~LockedJsonResponse() { if (_holding_lock) releaseJSONBufferLock(); };
+  virtual ~LockedJsonResponse() { if (_holding_lock) releaseJSONBuffer(_doc); };
+};
+
+// Streaming response: effect tables and palette names are written directly from PROGMEM into the TCP send buffer,
+// one entry at a time, so they never occupy the JSON buffer. For the full /json response the serialized state and
+// info document (without its closing brace) is sent first and the buffer is released as soon as it has been sent.
+class StreamingJsonResponse: public AsyncAbstractResponse {
+  public:
+  enum Content : uint8_t { MODE_NAMES, MODE_DATA, FULL };
+
+  private:
+  enum Stage : uint8_t { STAGE_DOC, STAGE_OPEN, STAGE_ENTRIES, STAGE_CLOSE, STAGE_PALETTES, STAGE_END, STAGE_DONE };
+  JsonDocument *_doc;   // state & info (FULL only), released once sent
+  size_t   _docLen;     // length of serialized document without closing brace
+  Content  _content;
+  uint8_t  _stage;
+  unsigned _mode;       // next effect table entry
+  size_t   _pos;        // position within document or palette names
+  bool     _first;      // no comma before first entry
+  size_t   _pieceLen, _piecePos;
+  char     _piece[2*256+4]; // escaped effect table entry
+
+  void _begin() {
+    _stage = _doc ? STAGE_DOC : STAGE_OPEN;
+    _mode = _pos = _pieceLen = _piecePos = 0;
+    _first = true;
+  }
+
+  // renders next piece of response after document into _piece, returns its length (0 when done)
+  size_t _nextPiece() {
+    const bool full = (_content == FULL);
+    switch (_stage) {
+      case STAGE_OPEN:
+        _stage = STAGE_ENTRIES;
+        strcpy_P(_piece, full ? PSTR(",\"effects\":[") : PSTR("["));
+        return strlen(_piece);
+      case STAGE_ENTRIES:
+        while (_mode < strip.getModeCount()) {
+          char lineBuffer[256];
+          strncpy_P(lineBuffer, strip.getModeData(_mode++), sizeof(lineBuffer)-1);
+          lineBuffer[sizeof(lineBuffer)-1] = '\0';
+          if (lineBuffer[0] == 0) continue; // effect with empty data string is left out of both names and data tables
+          char *dataPtr = strchr(lineBuffer, '@');
+          const char *str = lineBuffer;
+          if (_content == MODE_DATA) str = dataPtr ? dataPtr+1 : "";
+          else if (dataPtr) *dataPtr = 0; // remove effect data from name
+          size_t len = 0;
+          if (!_first) _piece[len++] = ',';
+          _first = false;
+          _piece[len++] = '"';
+          for (; *str; str++) {
+            if (*str == '"' || *str == '\\') _piece[len++] = '\\';
+            _piece[len++] = (*str < ' ') ? ' ' : *str; // control characters are not valid in JSON strings
+          }
+          _piece[len++] = '"';
+          return len;
+        }
+        _stage = STAGE_CLOSE;
+        // fall through
+      case STAGE_CLOSE:
+        _stage = full ? STAGE_PALETTES : STAGE_DONE;
+        strcpy_P(_piece, full ? PSTR("],\"palettes\":") : PSTR("]"));
+        return strlen(_piece);
+      case STAGE_PALETTES: {
+        size_t len = min(sizeof(_piece), strlen_P(JSON_palette_names) - _pos);
+        memcpy_P(_piece, JSON_palette_names + _pos, len);
+        _pos += len;
+        if (len < sizeof(_piece)) _stage = STAGE_END;
+        if (len) return len;
+      } // fall through
+      case STAGE_END:
+        _stage = STAGE_DONE;
+        _piece[0] = '}';
+        return 1;
+      default:
+        return 0;
+    }
+  }
+
+  public:
+  // doc must be acquired using requestJSONBuffer() and detached, it is released by the response
+  StreamingJsonResponse(Content content, JsonDocument *doc = nullptr) : _doc(doc), _docLen(0), _content(content) {
+    _code = 200;
+    _contentType = FPSTR(CONTENT_TYPE_JSON);
+    if (_doc) _docLen = measureJson(*_doc) - 1; // without closing brace
+    // measure content by rendering it once
+    _contentLength = _docLen;
+    _doc = nullptr;
+    _begin();
+    for (size_t len; (len = _nextPiece()) > 0; ) _contentLength += len;
+    _doc = doc;
+    _begin();
+  }
+
+  virtual ~StreamingJsonResponse() { if (_doc) releaseJSONBuffer(_doc); }
+
+  bool _sourceValid() const { return true; }
+
+  virtual size_t _fillBuffer(uint8_t *buf, size_t maxLen) {
+    size_t written = 0;
+    if (_stage == STAGE_DOC) {
+      written = min(maxLen, _docLen - _pos);
+      ChunkPrint dest(buf, _pos, written);
+      serializeJson(*_doc, dest);
+      _pos += written;
+      if (_pos >= _docLen) {
+        releaseJSONBuffer(_doc);
+        _doc = nullptr;
+        _pos = 0;
+        _stage = STAGE_OPEN;
+      }
+    }
+    while (written < maxLen && _stage != STAGE_DOC) {
+      if (_piecePos >= _pieceLen) {
+        _pieceLen = _nextPiece();
+        _piecePos = 0;
+        if (!_pieceLen) break;
+      }
+      size_t len = min(maxLen - written, _pieceLen - _piecePos);
+      memcpy(buf + written, _piece + _piecePos, len);
+      _piecePos += len;
+      written += len;
+    }
+    return written;
+  }
 };
 
 void serveJson(AsyncWebServerRequest* request)
@@ -1033,12 +1220,19 @@ void serveJson(AsyncWebServerRequest* request)
   else if (url.indexOf(F("palx"))  > 0) subJson = JSON_PATH_PALETTES;
   else if (url.indexOf(F("fxda"))  > 0) subJson = JSON_PATH_FXDATA;
   else if (url.indexOf(F("net"))   > 0) subJson = JSON_PATH_NETWORKS;
+  else if (url.indexOf(F("perf"))  > 0) subJson = JSON_PATH_PERF;
   #ifdef WLED_ENABLE_JSONLIVE
   else if (url.indexOf("live")     > 0) {
     serveLiveLeds(request);
     return;
   }
   #endif
+  #ifdef WLED_ENABLE_BENCHMARK
+  else if (url.indexOf(F("bench")) > 0) {
+    serveBenchmark(request);
+    return;
+  }
+  #endif
   else if (url.indexOf("pal") > 0) {
     request->send_P(200, FPSTR(CONTENT_TYPE_JSON), JSON_palette_names);
     return;
@@ -1051,13 +1245,33 @@ void serveJson(AsyncWebServerRequest* request)
     return;
   }
 
-  if (!requestJSONBufferLock(17)) {
+  // effect tables are streamed from PROGMEM and do not need JSON buffer
+  if (subJson == JSON_PATH_EFFECTS || subJson == JSON_PATH_FXDATA) {
+    request->send(new StreamingJsonResponse(subJson == JSON_PATH_EFFECTS ? StreamingJsonResponse::MODE_NAMES : StreamingJsonResponse::MODE_DATA));
+    return;
+  }
+
+  JsonDocument *doc = requestJSONBuffer(17); // pool document if available, global lock is held until detached
+  if (!doc) {
     serveJsonError(request, 503, ERR_NOBUF);
     return;
   }
-  // releaseJSONBufferLock() will be called when "response" is destroyed (from AsyncWebServer)
+
+  if (subJson == 0) { // full response: state & info from JSON buffer, effect and palette names are streamed
+    JsonObject root = doc->to<JsonObject>();
+    JsonObject state = root.createNestedObject("state");
+    serializeState(state);
+    JsonObject info = root.createNestedObject("info");
+    serializeInfo(info);
+    DEBUG_PRINTF_P(PSTR("JSON buffer size: %u for request: %d\n"), doc->memoryUsage(), subJson);
+    doc = detachJSONBuffer(doc); // pool document or copy sized to content, global buffer if it could not be copied
+    request->send(new StreamingJsonResponse(StreamingJsonResponse::FULL, doc)); // releases buffer when sent
+    return;
+  }
+
+  // releaseJSONBuffer() will be called when "response" is destroyed (from AsyncWebServer)
   // make sure you delete "response" if no "request->send(response);" is made
-  LockedJsonResponse *response = new LockedJsonResponse(pDoc, subJson==JSON_PATH_FXDATA || subJson==JSON_PATH_EFFECTS); // will clear and convert JsonDocument into JsonArray if necessary
+  LockedJsonResponse *response = new LockedJsonResponse(doc, false); // will clear and convert JsonDocument into JsonObject
 
   JsonVariant lDoc = response->getRoot();
 
@@ -1067,34 +1281,29 @@ void serveJson(AsyncWebServerRequest* request)
       serializeState(lDoc); break;
     case JSON_PATH_INFO:
       serializeInfo(lDoc); break;
+    case JSON_PATH_STATE_INFO: {
+      JsonObject state = lDoc.createNestedObject("state");
+      serializeState(state);
+      JsonObject info = lDoc.createNestedObject("info");
+      serializeInfo(info);
+      } break;
     case JSON_PATH_NODES:
       serializeNodes(lDoc); break;
     case JSON_PATH_PALETTES:
       serializePalettes(lDoc, request->hasParam(F("page")) ? request->getParam(F("page"))->value().toInt() : 0); break;
-    case JSON_PATH_EFFECTS:
-      serializeModeNames(lDoc); break;
-    case JSON_PATH_FXDATA:
-      serializeModeData(lDoc); break;
     case JSON_PATH_NETWORKS:
       serializeNetworks(lDoc); break;
-    default: //all
-      JsonObject state = lDoc.createNestedObject("state");
-      serializeState(state);
-      JsonObject info = lDoc.createNestedObject("info");
-      serializeInfo(info);
-      if (subJson != JSON_PATH_STATE_INFO)
-      {
-        JsonArray effects = lDoc.createNestedArray(F("effects"));
-        serializeModeNames(effects); // remove WLED-SR extensions from effect names
-        lDoc[F("palettes")] = serialized((const __FlashStringHelper*)JSON_palette_names);
-      }
-      //lDoc["m"] = lDoc.memoryUsage(); // JSON buffer usage, for remote debugging
+    case JSON_PATH_PERF:
+      serializePerf(lDoc);
+      if (request->hasParam(F("reset"))) PerfMonitor::reset();
+      break;
   }
 
   DEBUG_PRINTF_P(PSTR("JSON buffer size: %u for request: %d\n"), lDoc.memoryUsage(), subJson);
 
   [[maybe_unused]] size_t len = response->setLength();
   DEBUG_PRINTF_P(PSTR("JSON content length: %u\n"), len);
+  response->detach(); // state is serialized, others may use the global buffer while response is sent
 
   request->send(response);
 }
@@ -185,6 +185,27 @@ void publishMqtt()
 }
 
 
+// publishes loop watchdog state (JSON, same as "lwd" in /json/info) if a loop went over budget since last call
+void publishMqttLoopWatchdog()
+{
+  static uint32_t overruns = 0;
+  if (!WLED_MQTT_CONNECTED || PerfMonitor::getOverruns() == overruns) return;
+  overruns = PerfMonitor::getOverruns();
+
+  DynamicJsonDocument doc(1024);
+  serializeLoopWatchdog(doc.to<JsonObject>());
+  size_t len = measureJson(doc);
+  char *buf = (char*)malloc(len + 1);
+  if (!buf) return;
+  serializeJson(doc, buf, len + 1);
+  char subuf[48];
+  strlcpy(subuf, mqttDeviceTopic, 33);
+  strcat_P(subuf, PSTR("/lwd"));
+  mqtt->publish(subuf, 0, false, buf, len);
+  free(buf);
+}
+
+
 //HA autodiscovery was removed in favor of the native integration in HA v0.102.0
 
 bool initMqtt()
@@ -0,0 +1,79 @@
+#include "perf.h"
+
+/*
+ * Lightweight frame time profiler
+ * Recording a sample is a few integer operations so it can be left enabled in release builds.
+ * Loop watchdog only tracks the slowest loop stage per loop and compares loop time with budget when it ends.
+ */
+
+perf_stat PerfMonitor::_stats[PERF_STAGES] = {};
+uint32_t  PerfMonitor::_segAvg16[PERF_MAX_SEGMENTS] = {};
+uint32_t  PerfMonitor::_segMax[PERF_MAX_SEGMENTS] = {};
+uint16_t  PerfMonitor::_budgetMs = WLED_LOOP_BUDGET;
+uint32_t  PerfMonitor::_overruns = 0;
+uint16_t  PerfMonitor::_blame[PERF_STAGES] = {};
+uint8_t   PerfMonitor::_loopWorst = PERF_STAGES;
+uint32_t  PerfMonitor::_loopWorstUs = 0;
+uint8_t   PerfMonitor::_lastOffender = PERF_STAGES;
+uint32_t  PerfMonitor::_lastOffenderUs = 0;
+uint32_t  PerfMonitor::_lastOverrunUs = 0;
+
+static const char _perf_names[] PROGMEM = "fx\0trans\0comp\0show\0abl\0loop\0net\0um\0strip\0preset\0io\0sched\0hue\0maint\0ws";
+
+void PerfMonitor::record(uint8_t stage, uint32_t us) {
+  if (stage >= PERF_STAGES) return;
+  perf_stat &s = _stats[stage];
+  s.avg16 = s.count ? s.avg16 - (s.avg16 >> 4) + us : us << 4; // EMA with alpha = 1/16
+  s.last  = us;
+  if (us > s.max) s.max = us;
+  s.count++;
+  uint32_t v = us >> PERF_BUCKET_SHIFT;
+  unsigned bucket = v ? 32 - __builtin_clz(v) : 0; // 0: <64us, 1: <128us, 2: <256us, ...
+  if (bucket >= PERF_BUCKETS) bucket = PERF_BUCKETS-1;
+  s.hist[bucket]++;
+  if (++s.window >= PERF_WINDOW) {
+    // age histogram so that it reflects recent behaviour
+    for (unsigned i = 0; i < PERF_BUCKETS; i++) s.hist[i] >>= 1;
+    s.window = 0;
+  }
+
+  if ((PERF_LOOP_STAGES >> stage) & 1) {
+    if (us >= _loopWorstUs) {
+      _loopWorstUs = us;
+      _loopWorst   = stage;
+    }
+  } else if (stage == PERF_LOOP) {
+    if (_budgetMs && us > _budgetMs * 1000U && _loopWorst < PERF_STAGES) {
+      _overruns++;
+      if (_blame[_loopWorst] < UINT16_MAX) _blame[_loopWorst]++;
+      _lastOffender   = _loopWorst;
+      _lastOffenderUs = _loopWorstUs;
+      _lastOverrunUs  = us;
+    }
+    _loopWorst   = PERF_STAGES;
+    _loopWorstUs = 0;
+  }
+}
+
+void PerfMonitor::recordSegment(unsigned seg, uint32_t us) {
+  if (seg >= PERF_MAX_SEGMENTS) return;
+  _segAvg16[seg] = _segAvg16[seg] ? _segAvg16[seg] - (_segAvg16[seg] >> 4) + us : us << 4;
+  if (us > _segMax[seg]) _segMax[seg] = us;
+}
+
+void PerfMonitor::reset() {
+  memset(_stats, 0, sizeof(_stats));
+  memset(_segAvg16, 0, sizeof(_segAvg16));
+  memset(_segMax, 0, sizeof(_segMax));
+  memset(_blame, 0, sizeof(_blame));
+  _overruns       = 0;
+  _lastOffender   = PERF_STAGES;
+  _lastOffenderUs = 0;
+  _lastOverrunUs  = 0;
+}
+
+const char *PerfMonitor::getStageName(uint8_t stage) {
+  const char *name = _perf_names;
+  for (unsigned i = 0; i < stage && i < PERF_STAGES; i++) name += strlen_P(name) + 1;
+  return name;
+}
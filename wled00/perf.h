@@ -0,0 +1,86 @@
+#ifndef WLED_PERF_H
+#define WLED_PERF_H
+/*
+ * Lightweight frame time profiler
+ * Keeps rolling statistics and histograms of time spent in main processing stages (served at /json/perf)
+ * and acts as loop watchdog: if WLED::loop() exceeds budget, the slowest loop stage is blamed (in /json/info and MQTT)
+ */
+#include <Arduino.h>
+
+enum PerfStage : uint8_t {
+  PERF_EFFECT = 0,  // effect functions of all segments in a frame
+  PERF_TRANSITION,  // old effect functions while blending effects
+  PERF_COMPOSE,     // compositing segment layers into frame
+  PERF_SHOW,        // sending frame to buses (includes ABL)
+  PERF_ABL,         // current estimation of a digital bus
+  PERF_LOOP,        // whole WLED::loop()
+  PERF_NETWORK,     // connection handling and UDP notifications
+  PERF_USERMODS,    // usermod loops
+  PERF_STRIP,       // strip.service()
+  PERF_PRESET,      // applying a preset (lookup in presets.json, parsing and applying state)
+  PERF_IO,          // time, IR, serial, buttons, Alexa and other input handling
+  PERF_SCHED,       // DNS/OTA, nightlight and playlist handling
+  PERF_HUE,         // Philips Hue polling
+  PERF_MAINT,       // periodic maintenance (MQTT & node list refresh, heap check, bus re-init, config save)
+  PERF_WS,          // WebSocket handling
+  PERF_STAGES       // number of stages (keep last)
+};
+
+// stages timed directly in WLED::loop() (others are nested in them), the slowest one is blamed for a loop over budget
+#define PERF_LOOP_STAGES ((1U<<PERF_NETWORK) | (1U<<PERF_USERMODS) | (1U<<PERF_STRIP) | (1U<<PERF_PRESET) | (1U<<PERF_IO) | \
+                          (1U<<PERF_SCHED) | (1U<<PERF_HUE) | (1U<<PERF_MAINT) | (1U<<PERF_WS))
+
+#ifndef WLED_LOOP_BUDGET
+  #define WLED_LOOP_BUDGET 100 // ms, default loop watchdog budget (0 disables)
+#endif
+
+#define PERF_BUCKETS      12   // histogram buckets: <64us, <128us, <256us, ... , >=65ms
+#define PERF_BUCKET_SHIFT 6    // first bucket holds durations below 2^6 us
+#define PERF_WINDOW       1024 // histogram counts are halved after this many samples (rolling histogram)
+#define PERF_MAX_SEGMENTS 32   // segments beyond are not tracked
+
+typedef struct PerfStat {
+  uint32_t avg16;   // exponential moving average (us, fixed point x16)
+  uint32_t last;    // last duration (us)
+  uint32_t max;     // longest duration since reset (us)
+  uint32_t count;   // number of samples since reset
+  uint16_t window;  // samples since histogram was last aged
+  uint16_t hist[PERF_BUCKETS];
+} perf_stat;
+
+class PerfMonitor {
+  public:
+    static void record(uint8_t stage, uint32_t us);
+    static void recordSegment(unsigned seg, uint32_t us);
+    static void reset();
+
+    static inline const perf_stat &getStat(uint8_t stage)  { return _stats[stage < PERF_STAGES ? stage : 0]; }
+    static inline uint32_t getSegmentAvg(unsigned seg)     { return seg < PERF_MAX_SEGMENTS ? _segAvg16[seg] >> 4 : 0; }
+    static inline uint32_t getSegmentMax(unsigned seg)     { return seg < PERF_MAX_SEGMENTS ? _segMax[seg] : 0; }
+    static const char *getStageName(uint8_t stage);        // returns PROGMEM string
+
+    // loop watchdog
+    static inline void     setBudget(uint16_t ms)          { _budgetMs = ms; }
+    static inline uint16_t getBudget()                     { return _budgetMs; }
+    static inline uint32_t getOverruns()                   { return _overruns; }
+    static inline uint16_t getBlame(uint8_t stage)         { return stage < PERF_STAGES ? _blame[stage] : 0; }
+    static inline uint8_t  getLastOffender()               { return _lastOffender; }
+    static inline uint32_t getLastOffenderTime()           { return _lastOffenderUs; } // us spent in offending stage
+    static inline uint32_t getLastOverrun()                { return _lastOverrunUs; }  // us of whole loop
+
+  private:
+    static perf_stat _stats[PERF_STAGES];
+    static uint32_t  _segAvg16[PERF_MAX_SEGMENTS];
+    static uint32_t  _segMax[PERF_MAX_SEGMENTS];
+
+    static uint16_t  _budgetMs;
+    static uint32_t  _overruns;               // loops over budget since reset
+    static uint16_t  _blame[PERF_STAGES];     // number of overruns each stage was the slowest in
+    static uint8_t   _loopWorst;              // slowest loop stage in current loop
+    static uint32_t  _loopWorstUs;
+    static uint8_t   _lastOffender;
+    static uint32_t  _lastOffenderUs;
+    static uint32_t  _lastOverrunUs;
+};
+
+#endif
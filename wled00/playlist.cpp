@@ -49,6 +49,7 @@ void unloadPlaylist() {
   }
   currentPlaylist = playlistIndex = -1;
   playlistLen = playlistEntryDur = playlistOptions = 0;
+  clearPresetCache();
   DEBUG_PRINTLN(F("Playlist unloaded."));
 }
 
@@ -10,6 +10,7 @@ static char *tmpRAMbuffer = nullptr;
 
 static volatile byte presetToApply = 0;
 static volatile byte callModeToApply = 0;
+static volatile bool presetFromPlaylist = false;
 static volatile byte presetToSave = 0;
 static volatile int8_t saveLedmap = -1;
 static char *quickLoad = nullptr;
@@ -22,6 +23,76 @@ const char *getPresetsFileName(bool persistent) {
   return persistent ? presets_json : tmp_json;
 }
 
+/*
+ * Cache of parsed presets used by the active playlist, so playlist entries are applied without file system
+ * access and JSON parsing. Presets are cached when first applied by the playlist; once the cache is full
+ * remaining entries are loaded from file as usual (with cyclic playback any replacement policy would only thrash).
+ * Cache is cleared when the playlist is unloaded or presets are modified.
+ */
+#ifndef WLED_PRESET_CACHE_SIZE
+  #ifdef ESP8266
+    #define WLED_PRESET_CACHE_SIZE 8
+  #else
+    #define WLED_PRESET_CACHE_SIZE 24
+  #endif
+#endif
+#ifndef WLED_PRESET_CACHE_BYTES
+  #ifdef ESP8266
+    #define WLED_PRESET_CACHE_BYTES 6144
+  #else
+    #define WLED_PRESET_CACHE_BYTES 24576 // 4x that if PSRAM is available
+  #endif
+#endif
+
+typedef struct PresetCacheEntry {
+  byte id;
+  PSRAMDynamicJsonDocument *doc;
+} pce;
+
+static PresetCacheEntry presetCache[WLED_PRESET_CACHE_SIZE];
+static byte             presetCacheLen = 0;
+static size_t           presetCacheBytes = 0;
+static unsigned long    presetCacheTime = 0;     // presetsModifiedTime cache is valid for
+static byte             presetCacheValidate = 0; // cacheInvalidate cache is valid for (file upload)
+
+void clearPresetCache() {
+  for (unsigned i = 0; i < presetCacheLen; i++) delete presetCache[i].doc;
+  presetCacheLen = 0;
+  presetCacheBytes = 0;
+}
+
+static JsonDocument *getCachedPreset(byte id) {
+  if (presetCacheTime != presetsModifiedTime || presetCacheValidate != cacheInvalidate) {
+    clearPresetCache();
+    presetCacheTime = presetsModifiedTime;
+    presetCacheValidate = cacheInvalidate;
+    return nullptr;
+  }
+  for (unsigned i = 0; i < presetCacheLen; i++) if (presetCache[i].id == id) return presetCache[i].doc;
+  return nullptr;
+}
+
+// stores a copy of freshly loaded preset (must be called before deserializeState() modifies the document)
+static void cachePreset(byte id, const JsonDocument *src) {
+  if (presetCacheLen >= WLED_PRESET_CACHE_SIZE || !(*src)[F("playlist")].isNull()) return; // nested playlists reload the playlist
+  size_t size = src->memoryUsage();
+  size_t budget = WLED_PRESET_CACHE_BYTES;
+  #ifdef ARDUINO_ARCH_ESP32
+  if (psramSafe && psramFound()) budget *= 4;
+  #endif
+  if (size == 0 || presetCacheBytes + size > budget) return;
+  PSRAMDynamicJsonDocument *doc = new PSRAMDynamicJsonDocument(size);
+  if (!doc || doc->capacity() < size || !doc->set(*src) || doc->overflowed()) {
+    delete doc;
+    return;
+  }
+  presetCache[presetCacheLen].id  = id;
+  presetCache[presetCacheLen].doc = doc;
+  presetCacheLen++;
+  presetCacheBytes += size;
+  DEBUG_PRINTF_P(PSTR("Preset %u cached (%u bytes).\n"), (unsigned)id, (unsigned)size);
+}
+
 static void doSaveState() {
   bool persist = (presetToSave < 251);
 
@@ -69,7 +140,10 @@ static void doSaveState() {
   #endif
   writeObjectToFileUsingId(getPresetsFileName(persist), presetToSave, pDoc);
 
-  if (persist) presetsModifiedTime = toki.second(); //unix time
+  if (persist) {
+    presetsModifiedTime = toki.second(); //unix time
+    clearPresetCache();
+  }
   releaseJSONBufferLock();
   updateFSInfo();
 
@@ -120,6 +194,7 @@ bool applyPresetFromPlaylist(byte index)
   DEBUG_PRINTF_P(PSTR("Request to apply preset: %d\n"), index);
   presetToApply = index;
   callModeToApply = CALL_MODE_DIRECT_CHANGE;
+  presetFromPlaylist = true;
   return true;
 }
 
@@ -129,6 +204,7 @@ bool applyPreset(byte index, byte callMode)
   DEBUG_PRINTF_P(PSTR("Request to apply preset: %u\n"), index);
   presetToApply = index;
   callModeToApply = callMode;
+  presetFromPlaylist = false;
   return true;
 }
 
@@ -156,19 +232,26 @@ void handlePresets()
   bool changePreset = false;
   uint8_t tmpPreset = presetToApply; // store temporary since deserializeState() may call applyPreset()
   uint8_t tmpMode   = callModeToApply;
+  bool fromPlaylist = presetFromPlaylist && currentPlaylist >= 0;
 
   JsonObject fdo;
 
   presetToApply = 0; //clear request for preset
   callModeToApply = 0;
+  presetFromPlaylist = false;
 
   DEBUG_PRINTF_P(PSTR("Applying preset: %u\n"), (unsigned)tmpPreset);
+  unsigned long applyStart = micros();
 
   #if defined(ARDUINO_ARCH_ESP32S2) || defined(ARDUINO_ARCH_ESP32C3)
   unsigned long start = millis();
   while (strip.isUpdating() && millis() - start < FRAMETIME_FIXED) yield(); // wait for strip to finish updating, accessing FS during sendout causes glitches
   #endif
 
+  const JsonDocument *cached = fromPlaylist && tmpPreset < 255 ? getCachedPreset(tmpPreset) : nullptr;
+  if (cached) {
+    pDoc->set(*cached); // copy of already parsed preset, no file access
+  } else
   #ifdef ARDUINO_ARCH_ESP32
   if (tmpPreset==255 && tmpRAMbuffer!=nullptr) {
     deserializeJson(*pDoc,tmpRAMbuffer);
@@ -176,6 +259,7 @@ void handlePresets()
   #endif
   {
   presetErrFlag = readObjectFromFileUsingId(getPresetsFileName(tmpPreset < 255), tmpPreset, pDoc) ? ERR_NONE : ERR_FS_PLOAD;
+  if (fromPlaylist && presetErrFlag == ERR_NONE && tmpPreset < 255) cachePreset(tmpPreset, pDoc);
   }
   fdo = pDoc->as<JsonObject>();
 
@@ -198,6 +282,7 @@ void handlePresets()
     deserializeState(fdo, CALL_MODE_NO_NOTIFY, tmpPreset); // may change presetToApply by calling applyPreset()
   }
   if (!errorFlag && tmpPreset < 255 && changePreset) currentPreset = tmpPreset;
+  PerfMonitor::record(PERF_PRESET, micros() - applyStart);
 
   #if defined(ARDUINO_ARCH_ESP32)
   //Aircoookie recommended not to delete buffer
@@ -261,6 +346,7 @@ void savePreset(byte index, const char* pname, JsonObject sObj)
         initPresetsFile(); // just in case if someone deleted presets.json using /edit
         writeObjectToFileUsingId(getPresetsFileName(), index, pDoc);
         presetsModifiedTime = toki.second(); //unix time
+        clearPresetCache();
         updateFSInfo();
       }
       delete[] saveName;
@@ -280,5 +366,6 @@ void deletePreset(byte index) {
   StaticJsonDocument<24> empty;
   writeObjectToFileUsingId(getPresetsFileName(), index, &empty);
   presetsModifiedTime = toki.second(); //unix time
+  clearPresetCache();
   updateFSInfo();
 }
\ No newline at end of file
@@ -138,6 +138,7 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
     Bus::setCCTBlend(strip.cctBlending);
     Bus::setGlobalAWMode(request->arg(F("AW")).toInt());
     strip.setTargetFps(request->arg(F("FR")).toInt());
+    netBusPacing = constrain(request->arg(F("NP")).toInt(), 0, 5000);
     useGlobalLedBuffer = request->hasArg(F("LD"));
 
     bool busesChanged = false;
@@ -382,6 +383,7 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
     receiveNotificationPalette = request->hasArg(F("RP"));
     receiveSegmentOptions = request->hasArg(F("SO"));
     receiveSegmentBounds = request->hasArg(F("SG"));
+    clockSyncEnabled = request->hasArg(F("CK"));
     sendNotifications = request->hasArg(F("SS"));
     notifyDirect = request->hasArg(F("SD"));
     notifyButton = request->hasArg(F("SB"));
@@ -390,6 +392,7 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
 
     t = request->arg(F("UR")).toInt();
     if ((t>=0) && (t<30)) udpNumRetries = t;
+    syncProtocolV2 = request->hasArg(F("S2"));
 
 
     nodeListEnabled = request->hasArg(F("NL"));
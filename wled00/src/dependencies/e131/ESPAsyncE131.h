@@ -59,6 +59,7 @@ typedef struct ip_addr ip4_addr_t;
 #define ARTNET_OPCODE_OPDMX 0x5000
 #define ARTNET_OPCODE_OPPOLL 0x2000
 #define ARTNET_OPCODE_OPPOLLREPLY 0x2100
+#define ARTNET_OPCODE_OPSYNC 0x5200
 
 #define P_E131   0
 #define P_ARTNET 1
@@ -105,7 +106,7 @@ typedef union {
       uint32_t frame_vector;
       uint8_t  source_name[64];
       uint8_t  priority;
-      uint16_t reserved;
+      uint16_t sync_address; // universe of synchronization packets (0 = not synchronized), E1.31-2016
       uint8_t  sequence_number;
       uint8_t  options;
       uint16_t universe;
@@ -120,6 +121,15 @@ typedef union {
       uint8_t  property_values[513];
     } __attribute__((packed));
 	
+  struct { //E1.31 synchronization packet (E1.31-2016: 6.3)
+    uint8_t  sync_root[38];
+    uint16_t sync_flength;
+    uint32_t sync_vector;
+    uint8_t  sync_sequence_number;
+    uint16_t sync_universe;
+    uint16_t sync_reserved;
+  } __attribute__((packed));
+
 	struct { //Art-Net packet
     uint8_t  art_id[8];
     uint16_t art_opcode;
@@ -207,7 +217,9 @@ class ESPAsyncE131 {
     static const uint8_t ACN_ID[];
 	  static const uint8_t ART_ID[];
     static const uint32_t VECTOR_ROOT = 4;
+    static const uint32_t VECTOR_ROOT_EXTENDED = 8;
     static const uint32_t VECTOR_FRAME = 2;
+    static const uint32_t VECTOR_FRAME_SYNC = 1;
     static const uint8_t VECTOR_DMP = 2;
 
     AsyncUDP        udp;        // AsyncUDP
@@ -17,27 +17,96 @@ typedef struct PartialEspNowPacket {
   uint8_t data[247];
 } partial_packet_t;
 
-void notify(byte callMode, bool followUp)
-{
-#ifndef WLED_DISABLE_ESPNOW
-  if (!udpConnected && !useESPNowSync) return;
-#else
-  if (!udpConnected) return;
-#endif
-  if (!syncGroups || !sendNotificationsRT) return;
-  switch (callMode)
-  {
-    case CALL_MODE_INIT:          return;
-    case CALL_MODE_DIRECT_CHANGE: if (!notifyDirect) return; break;
-    case CALL_MODE_BUTTON:        if (!notifyButton) return; break;
-    case CALL_MODE_BUTTON_PRESET: if (!notifyButton) return; break;
-    case CALL_MODE_NIGHTLIGHT:    if (!notifyDirect) return; break;
-    case CALL_MODE_HUE:           if (!notifyHue)    return; break;
-    case CALL_MODE_PRESET_CYCLE:  if (!notifyDirect) return; break;
-    case CALL_MODE_ALEXA:         if (!notifyAlexa)  return; break;
-    default: return;
+/*
+ * Sync protocol v2 (delta packets)
+ * Packet: [0] magic, [1] type, [2-3] sequence, [4] flags, [5] number of segment records,
+ * [6-45] bytes 1-40 of legacy notifier packet (global state, timebase, system time, sync groups),
+ * followed by segment records: [0] segment index, [1] SEG_DIFFERS_* mask of included field groups, [2..] fields.
+ * Only segments (and field groups) that changed since previous packet are sent. Instead of blind retransmissions
+ * a header-only tail packet is sent; receivers that detect a sequence gap ask the sender for full state (NACK).
+ */
+#define SYNC_V2_MAGIC        0xC5
+#define SYNC_V2_STATE        0
+#define SYNC_V2_NACK         1
+#define SYNC_V2_CLOCK_REQ    2    // clock sync request: [2-5] requester's micros()
+#define SYNC_V2_CLOCK_RESP   3    // clock sync response: [2-5] echoed micros(), [6-9] hold time (us), [10-13] effect time (ms)
+#define SYNC_V2_FULL         0x01 // packet contains full state
+#define SYNC_V2_TAIL         0x02 // header only packet repeating last sequence number
+#define SYNC_V2_LEGACY_OFS   5    // legacy packet byte n is at n+SYNC_V2_LEGACY_OFS
+#define SYNC_V2_HDR_SIZE     (SYNC_V2_LEGACY_OFS+SEG_OFFSET)
+#define SYNC_V2_MIN_INTERVAL 50   // ms between two state packets, faster changes are coalesced
+#define SYNC_V2_TAIL_DELAY   250  // ms after state packet when tail packet is sent
+#define SYNC_V2_NACK_DELAY   250  // ms between two NACKs sent by receiver
+
+// legacy segment record byte ranges {offset, length, offset, length} for each SEG_DIFFERS_* field group
+static const uint8_t syncV2Groups[][5] = {
+  {SEG_DIFFERS_BRI,     10,  1,  0, 0}, // opacity
+  {SEG_DIFFERS_OPT,      9,  1, 28, 1}, // options
+  {SEG_DIFFERS_COL,     15, 13,  0, 0}, // colors & CCT
+  {SEG_DIFFERS_FX,      11,  4, 29, 3}, // mode, speed, intensity, palette, custom sliders & checks
+  {SEG_DIFFERS_BOUNDS,   1,  4, 32, 4}, // start, stop, startY, stopY
+  {SEG_DIFFERS_GSO,      5,  4,  0, 0}  // grouping, spacing, offset
+};
+#define SYNC_V2_ALL_FIELDS (SEG_DIFFERS_BRI | SEG_DIFFERS_OPT | SEG_DIFFERS_COL | SEG_DIFFERS_FX | SEG_DIFFERS_BOUNDS | SEG_DIFFERS_GSO)
+
+static uint8_t *syncTxSegs    = nullptr;        // segment records of last state packet sent
+static unsigned syncTxCount   = 0;              // number of records in syncTxSegs
+static uint16_t syncTxSeq     = 0;
+static bool     syncTxFull    = true;           // next state packet needs to contain full state
+static byte     syncTxPending = CALL_MODE_INIT; // call mode of coalesced notification waiting to be sent
+static unsigned long syncNackTime = 0;          // last NACK answered (sender) or sent (receiver)
+static uint8_t *syncRxImage   = nullptr;        // legacy packet assembled from received deltas
+static IPAddress syncRxIP;
+static uint16_t syncRxSeq     = 0;
+
+/*
+ * Clock sync: receiver periodically asks the node it receives notifications from for its effect time
+ * (millis() + strip.timebase). Round trip time is measured with micros() and the hold time reported by the
+ * sender is subtracted; the sample with the lowest RTT out of a window is used (least affected by queuing)
+ * and strip.timebase is slewed towards it (large offsets are stepped).
+ */
+#define CLOCK_SYNC_INTERVAL  500  // ms between clock sync requests
+#define CLOCK_SYNC_SAMPLES   4    // samples per timebase correction
+#define CLOCK_SYNC_STEP      50   // ms, larger offsets are stepped instead of slewed
+#define CLOCK_SYNC_SLEW      2    // ms, max timebase adjustment per correction
+#define CLOCK_SYNC_TIMEOUT   30000 // ms without response after which lock is lost
+
+static IPAddress clockSyncIP;               // node we sync effect time to (last notification sender)
+static uint32_t  clockSyncSent       = 0;   // micros() of outstanding request (0: none)
+static unsigned long clockSyncTime   = 0;   // millis() of last request
+static unsigned long clockSyncRecvTime = 0; // millis() of last valid response
+static uint8_t   clockSyncCount      = 0;   // samples in current window
+static uint32_t  clockSyncBestRTT    = UINT32_MAX;
+static int32_t   clockSyncBestOffset = 0;
+static uint32_t  clockSyncLastRTT    = 0;
+
+// returns SEG_DIFFERS_* mask of field groups that differ between two legacy segment records
+static uint8_t syncV2Differs(const uint8_t *a, const uint8_t *b) {
+  uint8_t d = 0;
+  for (const auto &g : syncV2Groups) {
+    if (memcmp(a+g[1], b+g[1], g[2]) || memcmp(a+g[3], b+g[3], g[4])) d |= g[0];
   }
-  byte udpOut[WLEDPACKETSIZE];  //TODO: optimize size to use only active segments
+  return d;
+}
+
+// copies field groups selected by mask from segment record into packet (pack) or vice versa
+// returns number of packet bytes (pkt may be nullptr to only get the size)
+static size_t syncV2Fields(uint8_t *rec, uint8_t *pkt, uint8_t mask, bool pack) {
+  size_t n = 0;
+  for (const auto &g : syncV2Groups) {
+    if (!(mask & g[0])) continue;
+    for (unsigned r = 1; r < 5; r += 2) {
+      if (pkt && pack) memcpy(pkt+n, rec+g[r], g[r+1]);
+      else if (pkt)    memcpy(rec+g[r], pkt+n, g[r+1]);
+      n += g[r+1];
+    }
+  }
+  return n;
+}
+
+// fills legacy notifier packet, returns number of segments included
+static unsigned buildNotifyPacket(byte *udpOut, byte callMode, bool followUp)
+{
   Segment& mainseg = strip.getMainSegment();
   udpOut[0] = 0; //0: wled notifier protocol 1: WARLS protocol
   udpOut[1] = callMode;
@@ -148,9 +217,87 @@ void notify(byte callMode, bool followUp)
 
   //uint16_t offs = SEG_OFFSET;
   //next value to be added has index: udpOut[offs + 0]
+  return s;
+}
+
+// sends v2 packet built from legacy packet: flags 0 sends state changes (broadcast),
+// SYNC_V2_TAIL sends header only, SYNC_V2_FULL sends full state without advancing sequence (answer to NACK)
+static void sendSyncV2(IPAddress ip, byte *udpOut, unsigned nsegs, uint8_t flags)
+{
+  const bool update = !flags;
+  if (update) {
+    syncTxSeq++;
+    if (!syncTxSegs) syncTxSegs = (uint8_t*)malloc(MAX_NUM_SEGMENTS*UDP_SEG_SIZE);
+    if (syncTxFull || !syncTxSegs) flags = SYNC_V2_FULL;
+  }
+  uint8_t masks[MAX_NUM_SEGMENTS];
+  unsigned records = 0;
+  for (unsigned i = 0; i < nsegs; i++) {
+    if (flags & SYNC_V2_TAIL) masks[i] = 0;
+    else if ((flags & SYNC_V2_FULL) || i >= syncTxCount) masks[i] = SYNC_V2_ALL_FIELDS;
+    else masks[i] = syncV2Differs(udpOut + SEG_OFFSET + i*UDP_SEG_SIZE, syncTxSegs + i*UDP_SEG_SIZE);
+    if (masks[i]) records++;
+  }
+
+  uint8_t hdr[SYNC_V2_HDR_SIZE];
+  hdr[0] = SYNC_V2_MAGIC;
+  hdr[1] = SYNC_V2_STATE;
+  hdr[2] = syncTxSeq >> 8;
+  hdr[3] = syncTxSeq & 0xFF;
+  hdr[4] = flags;
+  hdr[5] = records;
+  memcpy(hdr + SYNC_V2_LEGACY_OFS + 1, udpOut + 1, SEG_OFFSET - 1);
+  DEBUG_PRINTF_P(PSTR("UDP sending v2 packet: %u (%u records, flags %u)\n"), (unsigned)syncTxSeq, records, (unsigned)flags);
+  notifierUdp.beginPacket(ip, udpPort);
+  notifierUdp.write(hdr, sizeof(hdr));
+  for (unsigned i = 0; i < nsegs; i++) {
+    if (!masks[i]) continue;
+    uint8_t rec[2+UDP_SEG_SIZE];
+    rec[0] = i;
+    rec[1] = masks[i];
+    size_t n = syncV2Fields(udpOut + SEG_OFFSET + i*UDP_SEG_SIZE, rec + 2, masks[i], true);
+    notifierUdp.write(rec, n + 2);
+  }
+  notifierUdp.endPacket();
+
+  if (update && syncTxSegs) {
+    memcpy(syncTxSegs, udpOut + SEG_OFFSET, nsegs*UDP_SEG_SIZE);
+    syncTxCount = nsegs;
+    syncTxFull  = false;
+  }
+}
+
+void notify(byte callMode, bool followUp)
+{
+#ifndef WLED_DISABLE_ESPNOW
+  if (!udpConnected && !useESPNowSync) return;
+#else
+  if (!udpConnected) return;
+#endif
+  if (!syncGroups || !sendNotificationsRT) return;
+  switch (callMode)
+  {
+    case CALL_MODE_INIT:          return;
+    case CALL_MODE_DIRECT_CHANGE: if (!notifyDirect) return; break;
+    case CALL_MODE_BUTTON:        if (!notifyButton) return; break;
+    case CALL_MODE_BUTTON_PRESET: if (!notifyButton) return; break;
+    case CALL_MODE_NIGHTLIGHT:    if (!notifyDirect) return; break;
+    case CALL_MODE_HUE:           if (!notifyHue)    return; break;
+    case CALL_MODE_PRESET_CYCLE:  if (!notifyDirect) return; break;
+    case CALL_MODE_ALEXA:         if (!notifyAlexa)  return; break;
+    default: return;
+  }
+  if (syncProtocolV2 && !followUp && millis() - notificationSentTime < SYNC_V2_MIN_INTERVAL) {
+    syncTxPending = callMode; // coalesce rapid changes (i.e. slider drags), sent from handleNotifications()
+    return;
+  }
+  syncTxPending = CALL_MODE_INIT;
+  byte udpOut[WLEDPACKETSIZE];  //TODO: optimize size to use only active segments
+  size_t s = buildNotifyPacket(udpOut, callMode, followUp);
 
 #ifndef WLED_DISABLE_ESPNOW
-  if (enableESPNow && useESPNowSync && statusESPNow == ESP_NOW_STATE_ON) {
+  // ESP-NOW uses legacy packets, v2 tail packets only replace UDP retransmissions
+  if (enableESPNow && useESPNowSync && statusESPNow == ESP_NOW_STATE_ON && !(syncProtocolV2 && followUp && notificationCount >= udpNumRetries)) {
     partial_packet_t buffer = {'W', 0, 1, {0}};
     // send global data
     DEBUG_PRINTLN(F("ESP-NOW sending first packet."));
@@ -195,21 +342,27 @@ void notify(byte callMode, bool followUp)
   if (udpConnected) 
 #endif
   {
-    DEBUG_PRINTLN(F("UDP sending packet."));
     IPAddress broadcastIp = ~uint32_t(Network.subnetMask()) | uint32_t(Network.gatewayIP());
-    notifierUdp.beginPacket(broadcastIp, udpPort);
-    notifierUdp.write(udpOut, WLEDPACKETSIZE); // TODO: add actual used buffer size
-    notifierUdp.endPacket();
+    if (syncProtocolV2) {
+      sendSyncV2(broadcastIp, udpOut, s, followUp ? SYNC_V2_TAIL : 0);
+    } else {
+      DEBUG_PRINTLN(F("UDP sending packet."));
+      notifierUdp.beginPacket(broadcastIp, udpPort);
+      notifierUdp.write(udpOut, WLEDPACKETSIZE); // TODO: add actual used buffer size
+      notifierUdp.endPacket();
+    }
   }
   notificationSentCallMode = callMode;
   notificationSentTime = millis();
   notificationCount = followUp ? notificationCount + 1 : 0;
 }
 
-void parseNotifyPacket(uint8_t *udpIn) {
+// applies legacy notifier packet, segment records with index not set in segMask are skipped
+// returns false if packet was ignored
+bool parseNotifyPacket(uint8_t *udpIn, uint32_t segMask = UINT32_MAX) {
   //ignore notification if received within a second after sending a notification ourselves
-  if (millis() - notificationSentTime < 1000) return;
-  if (udpIn[1] > 199) return; //do not receive custom versions
+  if (millis() - notificationSentTime < 1000) return false;
+  if (udpIn[1] > 199) return false; //do not receive custom versions
 
   //compatibilityVersionByte:
   byte version = udpIn[11];
@@ -218,8 +371,8 @@ void parseNotifyPacket(uint8_t *udpIn) {
   // if we are not part of any sync group ignore message
   if (version < 9) {
     // legacy senders are treated as if sending in sync group 1 only
-    if (!(receiveGroups & 0x01)) return;
-  } else if (!(receiveGroups & udpIn[36])) return;
+    if (!(receiveGroups & 0x01)) return false;
+  } else if (!(receiveGroups & udpIn[36])) return false;
 
   bool someSel = (receiveNotificationBrightness || receiveNotificationColor || receiveNotificationEffects || receiveNotificationPalette);
 
@@ -271,6 +424,7 @@ void parseNotifyPacket(uint8_t *udpIn) {
     for (size_t i = 0; i < numSrcSegs && i < strip.getMaxSegments(); i++) {
       unsigned ofs = 41 + i*udpIn[40]; //start of segment offset byte
       unsigned id = udpIn[0 +ofs];
+      const bool unchanged = !(segMask & (1UL << i)) && id < strip.getSegmentsNum(); // unchanged since last v2 packet
       DEBUG_PRINTF_P(PSTR("UDP segment received: %u\n"), id);
       if      (id >  strip.getSegmentsNum()) break;
       else if (id == strip.getSegmentsNum()) {
@@ -291,6 +445,7 @@ void parseNotifyPacket(uint8_t *udpIn) {
           id += inactiveSegs; // adjust id
         }
       }
+      if (unchanged) continue; // skip only after inactive segments were counted so ids of following segments stay aligned
       DEBUG_PRINTF_P(PSTR("UDP segment processing: %u\n"), id);
 
       uint16_t start  = (udpIn[1+ofs] << 8 | udpIn[2+ofs]);
@@ -370,7 +525,7 @@ void parseNotifyPacket(uint8_t *udpIn) {
     stateChanged = true;
   }
 
-  if (applyEffects && version > 5) {
+  if (applyEffects && version > 5 && !clockSyncLocked) { // clock sync keeps timebase aligned more precisely
     uint32_t t = (udpIn[25] << 24) | (udpIn[26] << 16) | (udpIn[27] << 8) | (udpIn[28]);
     t += PRESUMED_NETWORK_DELAY; //adjust trivially for network delay
     t -= millis();
@@ -406,16 +561,170 @@ void parseNotifyPacket(uint8_t *udpIn) {
 
   if (receiveNotificationBrightness || !someSel) bri = udpIn[2];
   stateUpdated(CALL_MODE_NOTIFICATION);
+  return true;
+}
+
+// sender of applied notifications becomes the clock sync reference
+static void setClockSyncMaster(IPAddress ip)
+{
+  if (ip == clockSyncIP) return;
+  clockSyncIP = ip;
+  clockSyncLocked = false;
+  clockSyncCount  = 0;
+  clockSyncBestRTT = UINT32_MAX;
+}
+
+static void sendClockSyncRequest()
+{
+  clockSyncSent = micros() | 1; // never 0
+  clockSyncTime = millis();
+  const uint8_t req[6] = {SYNC_V2_MAGIC, SYNC_V2_CLOCK_REQ, uint8_t(clockSyncSent >> 24), uint8_t(clockSyncSent >> 16), uint8_t(clockSyncSent >> 8), uint8_t(clockSyncSent)};
+  notifierUdp.beginPacket(clockSyncIP, udpPort);
+  notifierUdp.write(req, sizeof(req));
+  notifierUdp.endPacket();
+}
+
+static void answerClockSyncRequest(const uint8_t *udpIn, size_t len, IPAddress ip, uint32_t recvTime)
+{
+  if (len < 6) return;
+  uint8_t resp[14];
+  resp[0] = SYNC_V2_MAGIC;
+  resp[1] = SYNC_V2_CLOCK_RESP;
+  memcpy(resp + 2, udpIn + 2, 4);
+  notifierUdp.beginPacket(ip, udpPort);
+  uint32_t t = millis() + strip.timebase;
+  uint32_t hold = micros() - recvTime;
+  for (unsigned i = 0; i < 4; i++) {
+    resp[6 +i] = hold >> (24 - 8*i);
+    resp[10+i] = t    >> (24 - 8*i);
+  }
+  notifierUdp.write(resp, sizeof(resp));
+  notifierUdp.endPacket();
+}
+
+static void parseClockSyncResponse(const uint8_t *udpIn, size_t len, IPAddress ip, uint32_t recvTime)
+{
+  if (len < 14 || ip != clockSyncIP || !clockSyncSent) return;
+  uint32_t sent = (udpIn[2] << 24) | (udpIn[3] << 16) | (udpIn[4] << 8) | udpIn[5];
+  if (sent != clockSyncSent) return; // stale response
+  clockSyncSent = 0;
+  uint32_t hold = (udpIn[6] << 24) | (udpIn[7] << 16) | (udpIn[8] << 8) | udpIn[9];
+  uint32_t t    = (udpIn[10] << 24) | (udpIn[11] << 16) | (udpIn[12] << 8) | udpIn[13];
+  uint32_t rtt  = recvTime - sent;
+  rtt = rtt > hold ? rtt - hold : 0;
+  // sender's effect time now is its reported time plus one way delay
+  int32_t offset = int32_t(t + (rtt/2 + 500)/1000 - (millis() + strip.timebase));
+  unsigned dRTT = rtt > clockSyncLastRTT ? rtt - clockSyncLastRTT : clockSyncLastRTT - rtt;
+  if (clockSyncLastRTT) clockSyncJitter += (int32_t(dRTT/2) - int32_t(clockSyncJitter)) / 8; // smoothed one way delay variation
+  clockSyncLastRTT  = rtt;
+  clockSyncRecvTime = millis();
+  if (rtt < clockSyncBestRTT) {
+    clockSyncBestRTT    = rtt;
+    clockSyncBestOffset = offset;
+  }
+  if (++clockSyncCount < CLOCK_SYNC_SAMPLES) return;
+
+  clockSyncOffset = clockSyncBestOffset;
+  clockSyncRTT    = clockSyncBestRTT;
+  if (!clockSyncLocked || abs(clockSyncOffset) > CLOCK_SYNC_STEP) strip.timebase += clockSyncOffset;
+  else strip.timebase += constrain(clockSyncOffset, -CLOCK_SYNC_SLEW, CLOCK_SYNC_SLEW);
+  clockSyncLocked  = true;
+  clockSyncCount   = 0;
+  clockSyncBestRTT = UINT32_MAX;
+  DEBUG_PRINTF_P(PSTR("Clock sync: offset %d ms, RTT %u us\n"), (int)clockSyncOffset, (unsigned)clockSyncRTT);
+}
+
+// called from handleNotifications()
+static void handleClockSync()
+{
+  if (!clockSyncEnabled) clockSyncLocked = false;
+  if (!clockSyncEnabled || clockSyncIP[0] == 0) return;
+  if (clockSyncLocked && millis() - clockSyncRecvTime > CLOCK_SYNC_TIMEOUT) {
+    clockSyncLocked = false; // sender gone, notifications will set timebase again
+    clockSyncCount  = 0;
+    clockSyncBestRTT = UINT32_MAX;
+  }
+  if (millis() - clockSyncTime >= CLOCK_SYNC_INTERVAL) sendClockSyncRequest();
+}
+
+// answers NACK by unicasting full state, if many nodes ask at once full state is broadcast instead
+static void answerSyncV2Nack(IPAddress ip)
+{
+  if (!syncProtocolV2 || notificationSentCallMode == CALL_MODE_INIT) return;
+  if (millis() - syncNackTime < SYNC_V2_MIN_INTERVAL) {
+    syncTxFull = true;
+    if (syncTxPending == CALL_MODE_INIT) syncTxPending = notificationSentCallMode;
+  } else if (syncGroups && sendNotificationsRT) {
+    byte udpOut[WLEDPACKETSIZE];
+    unsigned s = buildNotifyPacket(udpOut, notificationSentCallMode, false);
+    sendSyncV2(ip, udpOut, s, SYNC_V2_FULL);
+  }
+  syncNackTime = millis();
+}
+
+// patches received v2 deltas into legacy packet image and applies changed segments
+static void parseSyncV2Packet(const uint8_t *udpIn, size_t len, IPAddress ip)
+{
+  const uint32_t recvTime = micros();
+  if (len < 4) return;
+  if (udpIn[1] == SYNC_V2_CLOCK_REQ)  { answerClockSyncRequest(udpIn, len, ip, recvTime); return; }
+  if (udpIn[1] == SYNC_V2_CLOCK_RESP) { parseClockSyncResponse(udpIn, len, ip, recvTime); return; }
+  if (udpIn[1] == SYNC_V2_NACK) {
+    DEBUG_PRINTF_P(PSTR("UDP v2 NACK from: %d.%d.%d.%d\n"), ip[0], ip[1], ip[2], ip[3]);
+    answerSyncV2Nack(ip);
+    return;
+  }
+  if (udpIn[1] != SYNC_V2_STATE || len < SYNC_V2_HDR_SIZE || realtimeMode) return;
+  if (!(receiveGroups & udpIn[36 + SYNC_V2_LEGACY_OFS])) return;
+
+  const uint16_t seq = (udpIn[2] << 8) | udpIn[3];
+  const uint8_t flags = udpIn[4];
+  const bool known = syncRxImage && ip == syncRxIP;
+  if (known && seq == syncRxSeq) return; // tail or repeated state, we are in sync
+  if (!(flags & SYNC_V2_FULL) && (!known || (flags & SYNC_V2_TAIL) || seq != uint16_t(syncRxSeq + 1))) {
+    // missed a packet (or unknown sender), ask for full state
+    if (millis() - syncNackTime < SYNC_V2_NACK_DELAY) return;
+    DEBUG_PRINTF_P(PSTR("UDP v2 sequence gap: %u -> %u\n"), (unsigned)syncRxSeq, (unsigned)seq);
+    const uint8_t nack[4] = {SYNC_V2_MAGIC, SYNC_V2_NACK, udpIn[2], udpIn[3]};
+    notifierUdp.beginPacket(ip, udpPort);
+    notifierUdp.write(nack, sizeof(nack));
+    notifierUdp.endPacket();
+    syncNackTime = millis();
+    return;
+  }
+
+  if (!syncRxImage) syncRxImage = (uint8_t*)calloc(WLEDPACKETSIZE, 1);
+  if (!syncRxImage) return;
+  syncRxImage[0] = 0;
+  memcpy(syncRxImage + 1, udpIn + SYNC_V2_LEGACY_OFS + 1, SEG_OFFSET - 1);
+  syncRxImage[40] = UDP_SEG_SIZE;
+  uint32_t segMask = 0;
+  size_t pos = SYNC_V2_HDR_SIZE;
+  for (unsigned r = 0; r < udpIn[5]; r++) {
+    if (pos + 2 > len) break;
+    unsigned idx  = udpIn[pos];
+    uint8_t  mask = udpIn[pos+1];
+    size_t   n    = syncV2Fields(nullptr, nullptr, mask, false);
+    if (idx >= MAX_NUM_SEGMENTS || pos + 2 + n > len) break;
+    uint8_t *rec = syncRxImage + SEG_OFFSET + idx*UDP_SEG_SIZE;
+    rec[0] = idx;
+    syncV2Fields(rec, const_cast<uint8_t*>(udpIn) + pos + 2, mask, false);
+    segMask |= 1UL << idx;
+    pos += n + 2;
+  }
+  DEBUG_PRINTF_P(PSTR("UDP v2 packet: %u (%u records)\n"), (unsigned)seq, (unsigned)udpIn[5]);
+  // advance sequence only if the packet was applied, a dropped delta causes a gap (and NACK) on the next packet
+  if (!parseNotifyPacket(syncRxImage, (flags & SYNC_V2_FULL) ? UINT32_MAX : segMask)) return;
+  syncRxIP  = ip;
+  syncRxSeq = seq;
+  setClockSyncMaster(ip);
 }
 
 void realtimeLock(uint32_t timeoutMs, byte md)
 {
   if (!realtimeMode && !realtimeOverride) {
-    unsigned stop, start;
     if (useMainSegmentOnly) {
       Segment& mainseg = strip.getMainSegment();
-      start = mainseg.start;
-      stop  = mainseg.stop;
       mainseg.freeze = true;
       // if WLED was off and using main segment only, freeze non-main segments so they stay off
       if (bri == 0) {
@@ -423,12 +732,13 @@ void realtimeLock(uint32_t timeoutMs, byte md)
           strip.getSegment(s).freeze = true;
         }
       }
+      // clear segment (its pixel buffer is composited in strip.show())
+      mainseg.beginDraw();
+      mainseg.fill(BLACK);
     } else {
-      start = 0;
-      stop  = strip.getLengthTotal();
+      // clear strip
+      for (size_t i = 0; i < strip.getLengthTotal(); i++) strip.setPixelColor(i,BLACK);
     }
-    // clear strip/segment
-    for (size_t i = start; i < stop; i++) strip.setPixelColor(i,BLACK);
   }
   // if strip is off (bri==0) and not already in RTM
   if (briT == 0 && !realtimeMode && !realtimeOverride) {
@@ -475,11 +785,31 @@ void handleNotifications()
 {
   IPAddress localIP;
 
+#ifndef WLED_DISABLE_ESPNOW
+  const bool canNotify = udpConnected || useESPNowSync;
+#else
+  const bool canNotify = udpConnected;
+#endif
+  if (canNotify && syncProtocolV2) {
+    // send coalesced notification or tail packet (at least one, even if retransmissions are disabled)
+    if (syncTxPending != CALL_MODE_INIT) {
+      if (millis() - notificationSentTime >= SYNC_V2_MIN_INTERVAL) {
+        byte callMode = syncTxPending;
+        syncTxPending = CALL_MODE_INIT;
+        notify(callMode);
+      }
+    } else if (notificationSentCallMode != CALL_MODE_INIT && (notificationCount == 0 || notificationCount < udpNumRetries) && millis() - notificationSentTime > SYNC_V2_TAIL_DELAY) {
+      notify(notificationSentCallMode, true);
+    }
+  } else
   //send second notification if enabled
   if(udpConnected && (notificationCount < udpNumRetries) && ((millis()-notificationSentTime) > 250)){
     notify(notificationSentCallMode,true);
   }
 
+  if (udpConnected) handleClockSync();
+
+  handleE131Frame();
   if (e131NewData && millis() - strip.getLastShow() > 15)
   {
     e131NewData = false;
@@ -562,11 +892,17 @@ void handleNotifications()
     return;
   }
 
+  //wled sync protocol v2 (delta packets)
+  if (udpIn[0] == SYNC_V2_MAGIC) {
+    parseSyncV2Packet(udpIn, len, isSupp ? notifier2Udp.remoteIP() : notifierUdp.remoteIP());
+    return;
+  }
+
   //wled notifier, ignore if realtime packets active
   if (udpIn[0] == 0 && !realtimeMode && receiveGroups)
   {
     DEBUG_PRINTF_P(PSTR("UDP notification from: %d.%d.%d.%d\n"), notifierUdp.remoteIP()[0], notifierUdp.remoteIP()[1], notifierUdp.remoteIP()[2], notifierUdp.remoteIP()[3]);
-    parseNotifyPacket(udpIn);
+    if (parseNotifyPacket(udpIn)) setClockSyncMaster(isSupp ? notifier2Udp.remoteIP() : notifierUdp.remoteIP()); // ignored packets do not re-target clock sync
     return;
   }
 
@@ -595,8 +931,8 @@ void handleNotifications()
     unsigned id = (tpmPayloadFrameSize/3)*(packetNum-1); //start LED
     unsigned totalLen = strip.getLengthTotal();
     if (useMainSegmentOnly) strip.getMainSegment().beginDraw(); // set up parameters for get/setPixelColor()
-    for (size_t i = 6; i < tpmPayloadFrameSize + 4U && id < totalLen; i += 3, id++) {
-      setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
+    if (id < totalLen && packetSize > 6) {
+      setRealtimePixels(id, udpIn + 6, min((unsigned)tpmPayloadFrameSize / 3, unsigned(packetSize - 6) / 3), 3);
     }
     if (tpmPacketCount == numPackets) { //reset packet count and show if all packets were received
       tpmPacketCount = 0;
@@ -631,30 +967,18 @@ void handleNotifications()
       }
     } else if (udpIn[0] == 2 && packetSize > 4) //drgb
     {
-      for (size_t i = 2, id = 0; i < packetSize -2 && id < totalLen; i += 3, id++)
-      {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-      }
+      setRealtimePixels(0, udpIn + 2, (packetSize - 2) / 3, 3);
     } else if (udpIn[0] == 3 && packetSize > 6) //drgbw
     {
-      for (size_t i = 2, id = 0; i < packetSize -3 && id < totalLen; i += 4, id++)
-      {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3]);
-      }
+      setRealtimePixels(0, udpIn + 2, (packetSize - 2) / 4, 4);
     } else if (udpIn[0] == 4 && packetSize > 7) //dnrgb
     {
       unsigned id = ((udpIn[3] << 0) & 0xFF) + ((udpIn[2] << 8) & 0xFF00);
-      for (size_t i = 4; i < packetSize -2 && id < totalLen; i += 3, id++)
-      {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-      }
+      if (id < totalLen) setRealtimePixels(id, udpIn + 4, (packetSize - 4) / 3, 3);
     } else if (udpIn[0] == 5 && packetSize > 8) //dnrgbw
     {
       unsigned id = ((udpIn[3] << 0) & 0xFF) + ((udpIn[2] << 8) & 0xFF00);
-      for (size_t i = 4; i < packetSize -2 && id < totalLen; i += 4, id++)
-      {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3]);
-      }
+      if (id < totalLen) setRealtimePixels(id, udpIn + 4, (packetSize - 4) / 4, 4);
     }
     strip.show();
     return;
@@ -697,6 +1021,33 @@ void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w)
   }
 }
 
+// sets count consecutive realtime pixels from packet data with 3 (RGB) or 4 (RGBW) channels per pixel
+// pixels are converted in chunks and passed to buses as spans instead of pixel by pixel
+void setRealtimePixels(uint16_t i, const uint8_t *data, unsigned count, unsigned channels)
+{
+  if (useMainSegmentOnly) { // segment mapping required
+    for (unsigned n = 0; n < count; n++, data += channels) setRealtimePixel(i + n, data[0], data[1], data[2], channels > 3 ? data[3] : 0);
+    return;
+  }
+  unsigned pix = i + arlsOffset;
+  const unsigned totalLen = strip.getLengthTotal();
+  if (pix >= totalLen) return;
+  count = min(count, totalLen - pix);
+  const bool gamma = !arlsDisableGammaCorrection && gammaCorrectCol;
+  uint32_t buf[64];
+  while (count) {
+    unsigned len = min(count, (unsigned)(sizeof(buf)/sizeof(uint32_t)));
+    for (unsigned n = 0; n < len; n++, data += channels) {
+      byte w = channels > 3 ? data[3] : 0;
+      if (gamma) buf[n] = RGBW32(gamma8(data[0]), gamma8(data[1]), gamma8(data[2]), gamma8(w));
+      else       buf[n] = RGBW32(data[0], data[1], data[2], w);
+    }
+    strip.setPixelColors(pix, len, buf);
+    pix   += len;
+    count -= len;
+  }
+}
+
 /*********************************************************************************************\
    Refresh aging for remote units, drop if too old...
 \*********************************************************************************************/
@@ -797,147 +1148,149 @@ void sendSysInfoUDP()
 // 1440 channels per packet
 #define DDP_CHANNELS_PER_PACKET 1440 // 480 leds
 
+#define DDP_HEADER_SIZE 10
+#define E131_HEADER_SIZE (E131_DMP_DATA+1) // including DMX start code
+#define BROADCAST_BUFFER_SIZE (DDP_HEADER_SIZE+DDP_CHANNELS_PER_PACKET) // largest packet
+
+//
+// Send real time UDP updates to the specified client(s)
 //
-// Send real time UDP updates to the specified client
+// type    - protocol type (0=DDP, 1=E1.31, 2=ArtNet)
+// client  - the IP address to send to
+// length  - the number of pixels
+// buffer  - a buffer of at least length*4 bytes long
+// isRGBW  - true if the buffer contains 4 components per pixel
+// clients - number of receivers at consecutive IP addresses (same data is sent to each)
 //
-// type   - protocol type (0=DDP, 1=E1.31, 2=ArtNet)
-// client - the IP address to send to
-// length - the number of pixels
-// buffer - a buffer of at least length*4 bytes long
-// isRGBW - true if the buffer contains 4 components per pixel
+// Each packet is built once (header and channel data with brightness applied) and then sent to all clients,
+// netBusPacing (us) is waited after each packet so that receivers and WiFi are not flooded with bursts.
 
 static       size_t sequenceNumber = 0; // this needs to be shared across all outputs
 static const size_t ART_NET_HEADER_SIZE = 12;
 static const byte   ART_NET_HEADER[] PROGMEM = {0x41,0x72,0x74,0x2d,0x4e,0x65,0x74,0x00,0x00,0x50,0x00,0x0e};
+static WiFiUDP      broadcastUdp;                 // shared by all network busses
+static uint8_t     *broadcastBuffer = nullptr;    // one packet (header + channel data)
 
-uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, uint8_t *buffer, uint8_t bri, bool isRGBW)  {
-  if (!(apActive || interfacesInited) || !client[0] || !length) return 1;  // network not initialised or dummy/unset IP address  031522 ajn added check for ap
+// scales channel values by brightness (same result as scale8()), 4 channels at a time
+static void scaleChannels(uint8_t *dst, const uint8_t *src, size_t len, uint8_t bri) {
+  if (bri == 255) {
+    memcpy(dst, src, len);
+    return;
+  }
+  const uint32_t scale = bri + 1;
+  size_t i = 0;
+  for (; i + 4 <= len; i += 4) {
+    uint32_t w;
+    memcpy(&w, src + i, 4);
+    // each channel has 16 bits of room in the product, so 2 channels per multiplication
+    uint32_t even = (((w     ) & 0x00FF00FFU) * scale >> 8) & 0x00FF00FFU;
+    uint32_t odd  = (((w >> 8) & 0x00FF00FFU) * scale     ) & 0xFF00FF00U;
+    w = even | odd;
+    memcpy(dst + i, &w, 4);
+  }
+  for (; i < len; i++) dst[i] = scale8(src[i], bri);
+}
 
-  WiFiUDP ddpUdp;
+static void buildE131Header(uint8_t *pkt, uint16_t universe, size_t channels) {
+  const size_t len = E131_HEADER_SIZE + channels;
+  memset(pkt, 0, E131_HEADER_SIZE);
+  pkt[E131_ROOT_PREAMBLE_SIZE+1] = 0x10;
+  memcpy_P(pkt + E131_ROOT_ID, PSTR("ASC-E1.17"), 9);
+  pkt[E131_ROOT_FLENGTH]    = 0x70 | ((len - E131_ROOT_FLENGTH) >> 8);
+  pkt[E131_ROOT_FLENGTH+1]  = (len - E131_ROOT_FLENGTH) & 0xFF;
+  pkt[E131_ROOT_VECTOR+3]   = 0x04; // VECTOR_ROOT_E131_DATA
+  memcpy_P(pkt + E131_ROOT_CID, PSTR("WLED"), 4);
+  strncpy(reinterpret_cast<char*>(pkt + E131_ROOT_CID + 4), escapedMac.c_str(), 12); // unique per device
+  pkt[E131_FRAME_FLENGTH]   = 0x70 | ((len - E131_FRAME_FLENGTH) >> 8);
+  pkt[E131_FRAME_FLENGTH+1] = (len - E131_FRAME_FLENGTH) & 0xFF;
+  pkt[E131_FRAME_VECTOR+3]  = 0x02; // VECTOR_E131_DATA_PACKET
+  strncpy(reinterpret_cast<char*>(pkt + E131_FRAME_SOURCE), serverDescription, 63);
+  pkt[E131_FRAME_PRIORITY]  = 100;
+  pkt[E131_FRAME_SEQ]       = sequenceNumber & 0xFF;
+  pkt[E131_FRAME_UNIVERSE]  = universe >> 8;
+  pkt[E131_FRAME_UNIVERSE+1]= universe & 0xFF;
+  pkt[E131_DMP_FLENGTH]     = 0x70 | ((len - E131_DMP_FLENGTH) >> 8);
+  pkt[E131_DMP_FLENGTH+1]   = (len - E131_DMP_FLENGTH) & 0xFF;
+  pkt[E131_DMP_VECTOR]      = 0x02; // VECTOR_DMP_SET_PROPERTY
+  pkt[E131_DMP_TYPE]        = 0xA1;
+  pkt[E131_DMP_ADDR_INC+1]  = 1;
+  pkt[E131_DMP_COUNT]       = (channels + 1) >> 8;
+  pkt[E131_DMP_COUNT+1]     = (channels + 1) & 0xFF;
+  // DMX start code (E131_DMP_DATA) is 0
+}
 
+uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, uint8_t *buffer, uint8_t bri, bool isRGBW, uint8_t clients)  {
+  if (!(apActive || interfacesInited) || !client[0] || !length || type > 2) return 1;  // network not initialised or dummy/unset IP address  031522 ajn added check for ap
+  if (!broadcastBuffer) broadcastBuffer = (uint8_t*)malloc(BROADCAST_BUFFER_SIZE);
+  if (!broadcastBuffer) return 1;
+
+  // calculate the number of UDP packets we need to send
+  const size_t channelCount = length * (isRGBW ? 4 : 3); // 1 channel for every R,G,B,(W?) value
+  size_t   channelsPerPacket = isRGBW ? 512 : 510; // E1.31 & Art-Net: 512/4=128 RGBW LEDs, 510/3=170 RGB LEDs
+  size_t   headerSize;
+  uint16_t port;
   switch (type) {
-    case 0: // DDP
-    {
-      // calculate the number of UDP packets we need to send
-      size_t channelCount = length * (isRGBW? 4:3); // 1 channel for every R,G,B value
-      size_t packetCount = ((channelCount-1) / DDP_CHANNELS_PER_PACKET) +1;
+    case 0:  channelsPerPacket = DDP_CHANNELS_PER_PACKET; headerSize = DDP_HEADER_SIZE; port = DDP_DEFAULT_PORT; break;
+    case 1:  headerSize = E131_HEADER_SIZE; port = E131_DEFAULT_PORT; break;
+    default: headerSize = ART_NET_HEADER_SIZE + 6; port = ARTNET_DEFAULT_PORT; break;
+  }
+  const size_t packetCount = ((channelCount-1) / channelsPerPacket) + 1;
+  if (type > 0 && ++sequenceNumber > 255) sequenceNumber = 0; // one sequence number per frame
 
-      // there are 3 channels per RGB pixel
-      uint32_t channel = 0; // TODO: allow specifying the start channel
-      // the current position in the buffer
-      size_t bufferOffset = 0;
+  uint8_t *pkt = broadcastBuffer;
+  size_t channel = 0; // TODO: allow specifying the start channel
+  for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
+    // the amount of data is AFTER the header in the current packet
+    const size_t packetSize = min(channelsPerPacket, channelCount - channel);
 
-      for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
+    switch (type) {
+      case 0: // DDP
         if (sequenceNumber > 15) sequenceNumber = 0;
-
-        if (!ddpUdp.beginPacket(client, DDP_DEFAULT_PORT)) {  // port defined in ESPAsyncE131.h
-          //DEBUG_PRINTLN(F("WiFiUDP.beginPacket returned an error"));
-          return 1; // problem
-        }
-
-        // the amount of data is AFTER the header in the current packet
-        size_t packetSize = DDP_CHANNELS_PER_PACKET;
-
-        uint8_t flags = DDP_FLAGS1_VER1;
-        if (currentPacket == (packetCount - 1U)) {
-          // last packet, set the push flag
-          // TODO: determine if we want to send an empty push packet to each destination after sending the pixel data
-          flags = DDP_FLAGS1_VER1 | DDP_FLAGS1_PUSH;
-          if (channelCount % DDP_CHANNELS_PER_PACKET) {
-            packetSize = channelCount % DDP_CHANNELS_PER_PACKET;
-          }
-        }
-
-        // write the header
-        /*0*/ddpUdp.write(flags);
-        /*1*/ddpUdp.write(sequenceNumber++ & 0x0F); // sequence may be unnecessary unless we are sending twice (as requested in Sync settings)
-        /*2*/ddpUdp.write(isRGBW ?  DDP_TYPE_RGBW32 : DDP_TYPE_RGB24);
-        /*3*/ddpUdp.write(DDP_ID_DISPLAY);
+        // last packet, set the push flag
+        // TODO: determine if we want to send an empty push packet to each destination after sending the pixel data
+        pkt[0] = (currentPacket == packetCount - 1U) ? (DDP_FLAGS1_VER1 | DDP_FLAGS1_PUSH) : DDP_FLAGS1_VER1;
+        pkt[1] = sequenceNumber++ & 0x0F; // sequence may be unnecessary unless we are sending twice (as requested in Sync settings)
+        pkt[2] = isRGBW ? DDP_TYPE_RGBW32 : DDP_TYPE_RGB24;
+        pkt[3] = DDP_ID_DISPLAY;
         // data offset in bytes, 32-bit number, MSB first
-        /*4*/ddpUdp.write(0xFF & (channel >> 24));
-        /*5*/ddpUdp.write(0xFF & (channel >> 16));
-        /*6*/ddpUdp.write(0xFF & (channel >>  8));
-        /*7*/ddpUdp.write(0xFF & (channel      ));
+        pkt[4] = 0xFF & (channel >> 24);
+        pkt[5] = 0xFF & (channel >> 16);
+        pkt[6] = 0xFF & (channel >>  8);
+        pkt[7] = 0xFF & (channel      );
         // data length in bytes, 16-bit number, MSB first
-        /*8*/ddpUdp.write(0xFF & (packetSize >> 8));
-        /*9*/ddpUdp.write(0xFF & (packetSize     ));
-
-        // write the colors, the write write(const uint8_t *buffer, size_t size)
-        // function is just a loop internally too
-        for (size_t i = 0; i < packetSize; i += (isRGBW?4:3)) {
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // R
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // G
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // B
-          if (isRGBW) ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // W
-        }
-
-        if (!ddpUdp.endPacket()) {
-          //DEBUG_PRINTLN(F("WiFiUDP.endPacket returned an error"));
-          return 1; // problem
-        }
-
-        channel += packetSize;
+        pkt[8] = 0xFF & (packetSize >> 8);
+        pkt[9] = 0xFF & (packetSize     );
+        break;
+      case 1: // E1.31, 1 full packet == 1 full universe (starting with universe 1)
+        buildE131Header(pkt, currentPacket + 1, packetSize);
+        break;
+      case 2: // Art-Net
+        memcpy_P(pkt, ART_NET_HEADER, ART_NET_HEADER_SIZE); // This doesn't change. Hard coded ID, OpCode, and protocol version.
+        pkt[ART_NET_HEADER_SIZE+0] = sequenceNumber & 0xFF; // sequence number. 1..255
+        pkt[ART_NET_HEADER_SIZE+1] = 0x00; // physical - more an FYI, not really used for anything. 0..3
+        pkt[ART_NET_HEADER_SIZE+2] = currentPacket & 0xFF; // Universe LSB. 1 full packet == 1 full universe, so just use current packet number.
+        pkt[ART_NET_HEADER_SIZE+3] = 0x00; // Universe MSB, unused.
+        pkt[ART_NET_HEADER_SIZE+4] = 0xFF & (packetSize >> 8); // 16-bit length of channel data, MSB
+        pkt[ART_NET_HEADER_SIZE+5] = 0xFF & (packetSize     ); // 16-bit length of channel data, LSB
+        break;
+    }
+    scaleChannels(pkt + headerSize, buffer + channel, packetSize, bri);
+
+    for (unsigned c = 0; c < clients; c++) {
+      IPAddress ip = client;
+      ip[3] += c;
+      if (!broadcastUdp.beginPacket(ip, port)) {
+        DEBUG_PRINTLN(F("Network bus WiFiUDP.beginPacket returned an error"));
+        return 1; // problem
       }
-    } break;
-
-    case 1: //E1.31
-    {
-    } break;
-
-    case 2: //ArtNet
-    {
-      // calculate the number of UDP packets we need to send
-      const size_t channelCount = length * (isRGBW?4:3); // 1 channel for every R,G,B,(W?) value
-      const size_t ARTNET_CHANNELS_PER_PACKET = isRGBW?512:510; // 512/4=128 RGBW LEDs, 510/3=170 RGB LEDs
-      const size_t packetCount = ((channelCount-1)/ARTNET_CHANNELS_PER_PACKET)+1;
-
-      uint32_t channel = 0; 
-      size_t bufferOffset = 0;
-
-      sequenceNumber++;
-
-      for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
-
-        if (sequenceNumber > 255) sequenceNumber = 0;
-
-        if (!ddpUdp.beginPacket(client, ARTNET_DEFAULT_PORT)) {
-          DEBUG_PRINTLN(F("Art-Net WiFiUDP.beginPacket returned an error"));
-          return 1; // borked
-        }
-
-        size_t packetSize = ARTNET_CHANNELS_PER_PACKET;
-
-        if (currentPacket == (packetCount - 1U)) {
-          // last packet
-          if (channelCount % ARTNET_CHANNELS_PER_PACKET) {
-            packetSize = channelCount % ARTNET_CHANNELS_PER_PACKET;
-          }
-        }
-
-        byte header_buffer[ART_NET_HEADER_SIZE];
-        memcpy_P(header_buffer, ART_NET_HEADER, ART_NET_HEADER_SIZE);
-        ddpUdp.write(header_buffer, ART_NET_HEADER_SIZE); // This doesn't change. Hard coded ID, OpCode, and protocol version.
-        ddpUdp.write(sequenceNumber & 0xFF); // sequence number. 1..255
-        ddpUdp.write(0x00); // physical - more an FYI, not really used for anything. 0..3
-        ddpUdp.write((currentPacket) & 0xFF); // Universe LSB. 1 full packet == 1 full universe, so just use current packet number.
-        ddpUdp.write(0x00); // Universe MSB, unused.
-        ddpUdp.write(0xFF & (packetSize >> 8)); // 16-bit length of channel data, MSB
-        ddpUdp.write(0xFF & (packetSize     )); // 16-bit length of channel data, LSB
-
-        for (size_t i = 0; i < packetSize; i += (isRGBW?4:3)) {
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // R
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // G
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // B
-          if (isRGBW) ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // W
-        }
-
-        if (!ddpUdp.endPacket()) {
-          DEBUG_PRINTLN(F("Art-Net WiFiUDP.endPacket returned an error"));
-          return 1; // borked
-        }
-        channel += packetSize;
+      broadcastUdp.write(pkt, headerSize + packetSize);
+      if (!broadcastUdp.endPacket()) {
+        DEBUG_PRINTLN(F("Network bus WiFiUDP.endPacket returned an error"));
+        return 1; // problem
       }
-    } break;
+      if (netBusPacing) delayMicroseconds(netBusPacing);
+    }
+    channel += packetSize;
   }
   return 0;
 }
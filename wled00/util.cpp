@@ -151,6 +151,13 @@ bool isAsterisksOnly(const char* str, byte maxLen)
 
 
 //threading/network callback details: https://github.com/Aircoookie/WLED/pull/2336#discussion_r762276994
+// updates JSON buffer lock wait statistics
+static void jsonLockWaited(unsigned long start) {
+  unsigned long waited = millis() - start;
+  jsonLockWaitTotal += waited;
+  if (waited > jsonLockWaitMax) jsonLockWaitMax = waited;
+}
+
 bool requestJSONBufferLock(uint8_t module)
 {
   if (pDoc == nullptr) {
@@ -158,24 +165,41 @@ bool requestJSONBufferLock(uint8_t module)
     return false;
   }
 
+  unsigned long start = millis();
+  jsonLockRequests++;
 #if defined(ARDUINO_ARCH_ESP32)
   // Use a recursive mutex type in case our task is the one holding the JSON buffer.
   // This can happen during large JSON web transactions.  In this case, we continue immediately
   // and then will return out below if the lock is still held.
-  if (xSemaphoreTakeRecursive(jsonBufferLockMutex, 250) == pdFALSE) return false;  // timed out waiting
+  if (xSemaphoreTakeRecursive(jsonBufferLockMutex, 0) == pdFALSE) {
+    jsonLockContended++;
+    bool locked = xSemaphoreTakeRecursive(jsonBufferLockMutex, 250) == pdTRUE;
+    jsonLockWaited(start);
+    if (!locked) {
+      jsonLockFailed++;
+      return false; // timed out waiting
+    }
+  }
 #elif defined(ARDUINO_ARCH_ESP8266)
   // If we're in system context, delay() won't return control to the user context, so there's
   // no point in waiting.
-  if (can_yield()) {
-    unsigned long now = millis();
-    while (jsonBufferLock && (millis()-now < 250)) delay(1); // wait for fraction for buffer lock
+  if (jsonBufferLock) {
+    jsonLockContended++;
+    if (can_yield()) {
+      while (jsonBufferLock && (millis()-start < 250)) delay(1); // wait for fraction for buffer lock
+      jsonLockWaited(start);
+    }
   }
+#elif defined(WLED_NATIVE)
+  // host build (test/native) is single threaded, a held lock cannot be released while waiting
+  if (jsonBufferLock) jsonLockContended++;
 #else
   #error Unsupported task framework - fix requestJSONBufferLock
 #endif  
   // If the lock is still held - by us, or by another task
   if (jsonBufferLock) {
     DEBUG_PRINTF_P(PSTR("ERROR: Locking JSON buffer (%d) failed! (still locked by %d)\n"), module, jsonBufferLock);
+    jsonLockFailed++;
 #ifdef ARDUINO_ARCH_ESP32
     xSemaphoreGiveRecursive(jsonBufferLockMutex);
 #endif
@@ -198,6 +222,91 @@ void releaseJSONBufferLock()
 #endif  
 }
 
+/*
+ * JSON documents for responses (GET /json/...)
+ * Response is serialized while the global JSON buffer lock is held (so state is not modified meanwhile) but the
+ * lock is released as soon as serialization is done and the response is sent to the (possibly slow) client from
+ * a separate document, without blocking state changes, presets or other requests.
+ * With PSRAM a pool of full size documents is kept in PSRAM and the response is serialized directly into one.
+ * Without PSRAM response is serialized into the global buffer and copied into a heap document sized to its
+ * content, which is freed after it has been sent.
+ * If no document is available the global buffer is used and held until the response is sent.
+ */
+#ifndef WLED_JSON_POOL_SIZE
+  #define WLED_JSON_POOL_SIZE 2 // only used with PSRAM
+#endif
+
+#ifdef ARDUINO_ARCH_ESP32
+static PSRAMDynamicJsonDocument *jsonPool[WLED_JSON_POOL_SIZE] = {nullptr};
+static volatile bool jsonPoolBusy[WLED_JSON_POOL_SIZE] = {false};
+#endif
+
+static inline bool useJSONPool() {
+#ifdef ARDUINO_ARCH_ESP32
+  return psramSafe && psramFound();
+#else
+  return false;
+#endif
+}
+
+JsonDocument *requestJSONBuffer(uint8_t module)
+{
+  if (!requestJSONBufferLock(module)) return nullptr;
+#ifdef ARDUINO_ARCH_ESP32
+  if (useJSONPool()) for (unsigned i = 0; i < WLED_JSON_POOL_SIZE; i++) {
+    if (jsonPoolBusy[i]) continue;
+    if (!jsonPool[i]) {
+      jsonPool[i] = new PSRAMDynamicJsonDocument(pDoc->capacity());
+      if (jsonPool[i] && jsonPool[i]->capacity() == 0) { delete jsonPool[i]; jsonPool[i] = nullptr; }
+      if (!jsonPool[i]) continue;
+    }
+    jsonPoolBusy[i] = true;
+    jsonPool[i]->clear();
+    return jsonPool[i];
+  }
+#endif
+  return pDoc; // serialize into global buffer (copied when detached)
+}
+
+// response is serialized, global buffer lock is no longer needed if response can be sent from another document
+// returns document to send the response from (the global buffer with lock still held if it could not be copied)
+JsonDocument *detachJSONBuffer(JsonDocument *doc)
+{
+  if (!doc) return nullptr;
+  if (doc == pDoc) {
+    const size_t need = pDoc->memoryUsage();
+    #ifdef ESP8266
+    if (ESP.getMaxFreeBlockSize() < need + 8192) return pDoc; // keep enough heap for everything else
+    #endif
+    DynamicJsonDocument *copy = new DynamicJsonDocument(need);
+    if (copy && (copy->capacity() < need || !copy->set(*pDoc) || copy->overflowed())) { delete copy; copy = nullptr; }
+    if (!copy) return pDoc;
+    doc = copy;
+  }
+  jsonPoolUsed++;
+  releaseJSONBufferLock();
+  return doc;
+}
+
+void releaseJSONBuffer(JsonDocument *doc, bool detached)
+{
+  if (!doc) return;
+  if (doc == pDoc) {
+    releaseJSONBufferLock();
+    return;
+  }
+  if (!detached) releaseJSONBufferLock();
+#ifdef ARDUINO_ARCH_ESP32
+  for (unsigned i = 0; i < WLED_JSON_POOL_SIZE; i++) {
+    if (jsonPool[i] != doc) continue;
+    jsonPool[i]->clear();
+    jsonPoolBusy[i] = false;
+    return;
+  }
+#endif
+  delete static_cast<DynamicJsonDocument*>(doc); // copy of global buffer
+}
+
 
 // extracts effect mode (or palette) name from names serialized string
 // caller must provide large enough buffer for name (including SR extensions)!
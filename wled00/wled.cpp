@@ -52,27 +52,40 @@ void WLED::loop()
   static size_t        avgStripMillis = 0;
   unsigned long        stripMillis;
 #endif
+  const uint32_t perfLoop = micros(); // profiler timestamps (also used by loop watchdog)
+  uint32_t perfTime, perfNet, perfIO;
 
   handleTime();
   #ifndef WLED_DISABLE_INFRARED
   handleIR();        // 2nd call to function needed for ESP32 to return valid results -- should be good for ESP8266, too
   #endif
+  perfTime = micros();
+  perfIO = perfTime - perfLoop;
   handleConnection();
+  perfNet = micros() - perfTime;
+  perfTime = micros();
   #ifdef WLED_ENABLE_ADALIGHT
   handleSerial();
   #endif
   handleImprovWifiScan();
+  perfIO += micros() - perfTime;
+  perfTime = micros();
   handleNotifications();
+  PerfMonitor::record(PERF_NETWORK, perfNet + micros() - perfTime);
+  perfTime = micros();
   handleTransitions();
   #ifdef WLED_ENABLE_DMX
   handleDMX();
   #endif
+  perfIO += micros() - perfTime;
 
   #ifdef WLED_DEBUG
   unsigned long usermodMillis = millis();
   #endif
+  perfTime = micros();
   userLoop();
   UsermodManager::loop();
+  PerfMonitor::record(PERF_USERMODS, micros() - perfTime);
   #ifdef WLED_DEBUG
   usermodMillis = millis() - usermodMillis;
   avgUsermodMillis += usermodMillis;
@@ -80,6 +93,7 @@ void WLED::loop()
   #endif
 
   yield();
+  perfTime = micros();
   handleIO();
   #ifndef WLED_DISABLE_INFRARED
   handleIR();
@@ -92,30 +106,42 @@ void WLED::loop()
     closeFile();
     yield();
   }
+  PerfMonitor::record(PERF_IO, perfIO + micros() - perfTime);
+
+  #ifdef WLED_ENABLE_BENCHMARK
+  handleBenchmark(); // runs one effect benchmark step (if started)
+  #endif
 
   #ifdef WLED_DEBUG
   stripMillis = millis();
   #endif
   if (!realtimeMode || realtimeOverride || (realtimeMode && useMainSegmentOnly))  // block stuff if WARLS/Adalight is enabled
   {
+    perfTime = micros();
     if (apActive) dnsServer.processNextRequest();
     #ifndef WLED_DISABLE_OTA
     if (WLED_CONNECTED && aOtaEnabled && !otaLock && correctPIN) ArduinoOTA.handle();
     #endif
     handleNightlight();
     handlePlaylist();
+    PerfMonitor::record(PERF_SCHED, micros() - perfTime);
     yield();
 
     #ifndef WLED_DISABLE_HUESYNC
+    perfTime = micros();
     handleHue();
+    PerfMonitor::record(PERF_HUE, micros() - perfTime);
     yield();
     #endif
 
     handlePresets();
     yield();
 
-    if (!offMode || strip.isOffRefreshRequired() || strip.needsUpdate())
+    if (!offMode || strip.isOffRefreshRequired() || strip.needsUpdate()) {
+      perfTime = micros();
       strip.service();
+      PerfMonitor::record(PERF_STRIP, micros() - perfTime);
+    }
     #ifdef ESP8266
     else if (!noWifiSleep)
       delay(1); //required to make sure ESP enters modem sleep (see #1184)
@@ -128,6 +154,7 @@ void WLED::loop()
   #endif
 
   yield();
+  perfTime = micros();
 #ifdef ESP8266
   MDNS.update();
 #endif
@@ -143,6 +170,7 @@ void WLED::loop()
     lastMqttReconnectAttempt = millis();
     #ifndef WLED_DISABLE_MQTT
     initMqtt();
+    publishMqttLoopWatchdog();
     #endif
     yield();
     // refresh WLED nodes list
@@ -231,12 +259,15 @@ void WLED::loop()
   }
   yield();
   if (doSerializeConfig) serializeConfig();
+  PerfMonitor::record(PERF_MAINT, micros() - perfTime);
 
   yield();
+  perfTime = micros();
   handleWs();
 #if defined(STATUSLED)
   handleStatusLED();
 #endif
+  PerfMonitor::record(PERF_WS, micros() - perfTime);
 
   toki.resetTick();
 
@@ -253,6 +284,16 @@ void WLED::loop()
   }
 #endif
 
+  PerfMonitor::record(PERF_LOOP, micros() - perfLoop);
+  #ifdef WLED_DEBUG
+  static uint32_t loopOverruns = 0;
+  if (PerfMonitor::getOverruns() != loopOverruns) {
+    loopOverruns = PerfMonitor::getOverruns();
+    DEBUG_PRINTF_P(PSTR("Loop over budget (%ums): %s took %ums.\n"), PerfMonitor::getLastOverrun()/1000,
+                   PerfMonitor::getStageName(PerfMonitor::getLastOffender()), PerfMonitor::getLastOffenderTime()/1000);
+  }
+  #endif
+
   if (doReboot && (!doInitBusses || !doSerializeConfig)) // if busses have to be inited & saved, wait until next iteration
     reset();
 
@@ -186,6 +186,7 @@ using PSRAMDynamicJsonDocument = BasicJsonDocument<PSRAM_Allocator>;
 #include "NodeStruct.h"
 #include "pin_manager.h"
 #include "bus_manager.h"
+#include "perf.h"
 #include "FX.h"
 
 #ifndef CLIENT_SSID
@@ -470,6 +471,10 @@ WLED_GLOBAL byte e131LastSequenceNumber[E131_MAX_UNIVERSE_COUNT]; // to detect p
 WLED_GLOBAL bool e131Multicast _INIT(false);                      // multicast or unicast
 WLED_GLOBAL bool e131SkipOutOfSequence _INIT(false);              // freeze instead of flickering
 WLED_GLOBAL uint16_t pollReplyCount _INIT(0);                     // count number of replies for ArtPoll node report
+WLED_GLOBAL uint32_t e131FramesShown _INIT(0);                    // E1.31/Art-Net frame assembly statistics: frames shown
+WLED_GLOBAL uint32_t e131PacketsLate _INIT(0);                    // out of sequence packets
+WLED_GLOBAL uint32_t e131PacketsDuplicate _INIT(0);               // packets repeated within a frame (ignored)
+WLED_GLOBAL uint32_t e131UniversesDropped _INIT(0);               // universes missing from frames shown after timeout
 
 // mqtt
 WLED_GLOBAL unsigned long lastMqttReconnectAttempt _INIT(0);  // used for other periodic tasks too
@@ -623,6 +628,12 @@ WLED_GLOBAL bool sendNotificationsRT  _INIT(false);           // master notifica
 WLED_GLOBAL unsigned long notificationSentTime _INIT(0);
 WLED_GLOBAL byte notificationSentCallMode _INIT(CALL_MODE_INIT);
 WLED_GLOBAL uint8_t notificationCount _INIT(0);
+WLED_GLOBAL bool syncProtocolV2 _INIT(false);                 // send sync notifications as delta packets (sync protocol v2)
+WLED_GLOBAL bool clockSyncEnabled _INIT(false);               // align effect timebase with notification sender (clock sync requests)
+WLED_GLOBAL bool clockSyncLocked _INIT(false);                // timebase is aligned by clock sync (notifications do not set it)
+WLED_GLOBAL int32_t  clockSyncOffset _INIT(0);                // last measured timebase offset to sender (ms)
+WLED_GLOBAL uint32_t clockSyncJitter _INIT(0);                // smoothed one way delay variation (us)
+WLED_GLOBAL uint32_t clockSyncRTT _INIT(0);                   // round trip time of best sample in last window (us)
 WLED_GLOBAL uint8_t syncGroups    _INIT(0x01);                // sync send groups this instance syncs to (bit mapped)
 WLED_GLOBAL uint8_t receiveGroups _INIT(0x01);                // sync receive groups this instance belongs to (bit mapped)
 #ifdef WLED_SAVE_RAM
@@ -748,6 +759,8 @@ WLED_GLOBAL bool     udp2Connected _INIT(false);
 WLED_GLOBAL bool     udpRgbConnected _INIT(false);
 #endif
 
+WLED_GLOBAL uint16_t netBusPacing _INIT(0);   // us to wait after each network bus (DDP/E1.31/Art-Net) packet
+
 // ui style
 WLED_GLOBAL bool showWelcomePage _INIT(false);
 
@@ -939,6 +952,12 @@ WLED_GLOBAL StaticJsonDocument<JSON_BUFFER_SIZE> gDoc;
 WLED_GLOBAL JsonDocument *pDoc _INIT(&gDoc);
 #endif
 WLED_GLOBAL volatile uint8_t jsonBufferLock _INIT(0);
+WLED_GLOBAL uint32_t jsonLockRequests  _INIT(0); // JSON buffer lock statistics: lock requests
+WLED_GLOBAL uint32_t jsonLockContended _INIT(0); // requests that found the buffer locked
+WLED_GLOBAL uint32_t jsonLockFailed    _INIT(0); // requests that timed out (ERR_NOBUF)
+WLED_GLOBAL uint32_t jsonLockWaitTotal _INIT(0); // total time spent waiting for the lock (ms)
+WLED_GLOBAL uint32_t jsonLockWaitMax   _INIT(0); // longest wait (ms)
+WLED_GLOBAL uint32_t jsonPoolUsed      _INIT(0); // responses sent from a pool document or copy (without global buffer lock)
 
 // enable additional debug output
 #if defined(WLED_DEBUG_HOST)
@@ -165,7 +165,10 @@ static void handleUpload(AsyncWebServerRequest *request, const String& filename,
 
     request->_tempFile = WLED_FS.open(finalname, "w");
     DEBUG_PRINTF_P(PSTR("Uploading %s\n"), finalname.c_str());
-    if (finalname.equals(FPSTR(getPresetsFileName()))) presetsModifiedTime = toki.second();
+    if (finalname.equals(FPSTR(getPresetsFileName()))) {
+      presetsModifiedTime = toki.second();
+      invalidatePresetIndex();
+    }
   }
   if (len) {
     request->_tempFile.write(data,len);
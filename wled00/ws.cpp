@@ -5,11 +5,130 @@
  */
 #ifdef WLED_ENABLE_WEBSOCKETS
 
-uint16_t wsLiveClientId = 0;
-unsigned long wsLastLiveTime = 0;
-//uint8_t* wsFrameBuffer = nullptr;
+// reassembly of JSON messages split into multiple frames/packets (one message at a time)
+#ifndef WS_MAX_MESSAGE_LEN
+  #ifdef ESP8266
+    #define WS_MAX_MESSAGE_LEN 8192
+  #else
+    #define WS_MAX_MESSAGE_LEN 16384
+  #endif
+#endif
+static char    *wsRxBuffer = nullptr;
+static size_t   wsRxSize = 0;      // allocated
+static size_t   wsRxLen = 0;       // received
+static uint32_t wsRxClient = 0;    // client sending the message
+static unsigned long wsRxStart = 0;
+static bool     wsRxOverflow = false;
+
+#define WS_MESSAGE_TIMEOUT 5000 // incomplete message is abandoned after this time (ms)
+
+static void freeWsRxBuffer() {
+  free(wsRxBuffer);
+  wsRxBuffer = nullptr;
+  wsRxSize = wsRxLen = 0;
+  wsRxClient = 0;
+}
+
+#define WS_LIVE_INTERVAL     40   // fastest live view frame interval (ms)
+#define WS_LIVE_INTERVAL_MAX 1000 // slowest adaptive frame interval (ms)
+#define WS_LIVE_KEYFRAME     5000 // v3 clients get a full frame at least this often (ms)
+#ifdef ESP8266
+  #define WS_MAX_LIVE_CLIENTS 2
+  #define WS_LIVE_MAX_LEDS_V3 1024
+#else
+  #define WS_MAX_LIVE_CLIENTS 4
+  #define WS_LIVE_MAX_LEDS_V3 4096
+#endif
+
+// clients receiving live view, each with its own adaptive frame rate and (v3) last sent frame for delta encoding
+typedef struct WSLiveClient {
+  uint32_t      id;       // WS client id (0 = unused slot)
+  uint8_t       version;  // live view protocol: 1 = legacy full frames (v1/v2), 3 = binary delta frames
+  uint16_t      interval; // current frame interval (ms)
+  unsigned long lastSent;
+  unsigned long lastKey;  // last full frame (v3)
+  uint8_t      *frame;    // last frame sent (v3)
+  size_t        frameLen;
+} ws_live_client;
+
+static WSLiveClient wsLiveClients[WS_MAX_LIVE_CLIENTS] = {};
+static uint8_t *wsLiveFrame = nullptr; // current frame shared by v3 clients
+static size_t   wsLiveFrameLen = 0;
+static unsigned wsLiveW = 0, wsLiveH = 0, wsLiveN = 1;
+
+// adds, updates or (version 0) removes live view client
+static void setLiveClient(uint32_t id, uint8_t version) {
+  bool v3Clients = false;
+  WSLiveClient *slot = nullptr;
+  for (auto &cl : wsLiveClients) {
+    if (cl.id == id || (!slot && !cl.id && version)) slot = &cl;
+  }
+  if (slot) {
+    if (slot->id == id && !version) { // remove
+      free(slot->frame);
+      memset(slot, 0, sizeof(WSLiveClient));
+    } else if (version) {
+      slot->id       = id;
+      slot->version  = version;
+      slot->interval = WS_LIVE_INTERVAL;
+      slot->lastKey  = 0; // start with full frame
+      slot->lastSent = millis() - WS_LIVE_INTERVAL;
+      if (slot->frame && version < 3) { free(slot->frame); slot->frame = nullptr; slot->frameLen = 0; }
+    }
+  }
+  for (auto &cl : wsLiveClients) if (cl.id && cl.version >= 3) v3Clients = true;
+  if (!v3Clients && wsLiveFrame) { // release shared frame buffer
+    free(wsLiveFrame);
+    wsLiveFrame = nullptr;
+    wsLiveFrameLen = 0;
+  }
+}
+
+// handles complete WS text message (JSON API)
+static void handleWsText(AsyncWebSocketClient * client, uint8_t *data, size_t len)
+{
+  if (len > 0 && len < 10 && data[0] == 'p') {
+    // application layer ping/pong heartbeat.
+    // client-side socket layer ping packets are unanswered (investigate)
+    client->text(F("pong"));
+    return;
+  }
 
-#define WS_LIVE_INTERVAL 40
+  bool verboseResponse = false;
+  if (!requestJSONBufferLock(11)) {
+    client->text(F("{\"error\":3}")); // ERR_NOBUF
+    return;
+  }
+
+  DeserializationError error = deserializeJson(*pDoc, data, len);
+  JsonObject root = pDoc->as<JsonObject>();
+  if (error || root.isNull()) {
+    releaseJSONBufferLock();
+    return;
+  }
+  if (root["v"] && root.size() == 1) {
+    //if the received value is just "{"v":true}", send only to this client
+    verboseResponse = true;
+  } else if (root.containsKey("lv")) {
+    // "lv":true requests legacy full frames, "lv":3 binary delta frames, "lv":false stops live view
+    JsonVariant lv = root["lv"];
+    setLiveClient(client->id(), lv.is<bool>() ? lv.as<bool>() : (lv | 0));
+  } else {
+    verboseResponse = deserializeState(root);
+  }
+  releaseJSONBufferLock();
+
+  if (!interfaceUpdateCallMode) { // individual client response only needed if no WS broadcast soon
+    if (verboseResponse) {
+      sendDataWs(client);
+    } else {
+      // we have to send something back otherwise WS connection closes
+      client->text(F("{\"success\":true}"));
+    }
+    // force broadcast in 500ms after updating client
+    //lastInterfaceUpdate = millis() - (INTERFACE_UPDATE_COOLDOWN -500); // ESP8266 does not like this
+  }
+}
 
 void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventType type, void * arg, uint8_t *data, size_t len)
 {
@@ -19,74 +138,60 @@ void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventTyp
     sendDataWs(client);
   } else if(type == WS_EVT_DISCONNECT){
     //client disconnected
-    if (client->id() == wsLiveClientId) wsLiveClientId = 0;
+    setLiveClient(client->id(), 0);
+    if (wsRxClient == client->id()) freeWsRxBuffer();
     DEBUG_PRINTLN(F("WS client disconnected."));
   } else if(type == WS_EVT_DATA){
     // data packet
     AwsFrameInfo * info = (AwsFrameInfo*)arg;
     if(info->final && info->index == 0 && info->len == len){
       // the whole message is in a single frame and we got all of its data (max. 1450 bytes)
-      if(info->opcode == WS_TEXT)
-      {
-        if (len > 0 && len < 10 && data[0] == 'p') {
-          // application layer ping/pong heartbeat.
-          // client-side socket layer ping packets are unanswered (investigate)
-          client->text(F("pong"));
-          return;
-        }
-
-        bool verboseResponse = false;
-        if (!requestJSONBufferLock(11)) {
-          client->text(F("{\"error\":3}")); // ERR_NOBUF
+      if(info->opcode == WS_TEXT) handleWsText(client, data, len);
+    } else {
+      //message is comprised of multiple frames or the frame is split into multiple packets
+      DEBUG_PRINTLN(F("WS multipart message."));
+      if (info->message_opcode != WS_TEXT) return;
+      if (info->num == 0 && info->index == 0) { // start of message
+        if (wsRxClient && wsRxClient != client->id() && millis() - wsRxStart < WS_MESSAGE_TIMEOUT) {
+          client->text(F("{\"error\":2}")); // ERR_CONCURRENCY, another client is sending a large message
           return;
         }
-
-        DeserializationError error = deserializeJson(*pDoc, data, len);
-        JsonObject root = pDoc->as<JsonObject>();
-        if (error || root.isNull()) {
-          releaseJSONBufferLock();
-          return;
+        wsRxClient = client->id();
+        wsRxStart = millis();
+        wsRxLen = 0;
+        wsRxOverflow = false;
+      }
+      if (wsRxClient != client->id()) return; // rest of rejected message
+      if (!wsRxOverflow) {
+        size_t need = wsRxLen + len;
+        if (need > WS_MAX_MESSAGE_LEN) {
+          wsRxOverflow = true;
+          free(wsRxBuffer); // message is rejected, release memory right away
+          wsRxBuffer = nullptr;
+          wsRxSize = 0;
         }
-        if (root["v"] && root.size() == 1) {
-          //if the received value is just "{"v":true}", send only to this client
-          verboseResponse = true;
-        } else if (root.containsKey("lv")) {
-          wsLiveClientId = root["lv"] ? client->id() : 0;
-        } else {
-          verboseResponse = deserializeState(root);
+        else if (need > wsRxSize) {
+          size_t size = min((need + 1023) & ~1023U, (size_t)WS_MAX_MESSAGE_LEN); // grow in 1kB steps
+          char *buf = (char*)realloc(wsRxBuffer, size);
+          if (buf) {
+            wsRxBuffer = buf;
+            wsRxSize = size;
+          } else wsRxOverflow = true;
         }
-        releaseJSONBufferLock();
-
-        if (!interfaceUpdateCallMode) { // individual client response only needed if no WS broadcast soon
-          if (verboseResponse) {
-            sendDataWs(client);
-          } else {
-            // we have to send something back otherwise WS connection closes
-            client->text(F("{\"success\":true}"));
-          }
-          // force broadcast in 500ms after updating client
-          //lastInterfaceUpdate = millis() - (INTERFACE_UPDATE_COOLDOWN -500); // ESP8266 does not like this
+        if (!wsRxOverflow) {
+          memcpy(wsRxBuffer + wsRxLen, data, len);
+          wsRxLen += len;
         }
       }
-    } else {
-      //message is comprised of multiple frames or the frame is split into multiple packets
-      //if(info->index == 0){
-        //if (!wsFrameBuffer && len < 4096) wsFrameBuffer = new uint8_t[4096];
-      //}
-
-      //if (wsFrameBuffer && len < 4096 && info->index + info->)
-      //{
-
-      //}
-
-      if((info->index + len) == info->len){
-        if(info->final){
-          if(info->message_opcode == WS_TEXT) {
-            client->text(F("{\"error\":9}")); // ERR_JSON we do not handle split packets right now
-          }
+      if (info->final && (info->index + len) == info->len) { // end of message
+        if (wsRxOverflow) {
+          DEBUG_PRINTLN(F("WS message too large."));
+          client->text(F("{\"error\":9}")); // ERR_JSON
+        } else {
+          handleWsText(client, (uint8_t*)wsRxBuffer, wsRxLen);
         }
+        freeWsRxBuffer();
       }
-      DEBUG_PRINTLN(F("WS multipart message."));
     }
   } else if(type == WS_EVT_ERROR){
     //error was received from the other end
@@ -160,11 +265,9 @@ void sendDataWs(AsyncWebSocketClient * client)
   releaseJSONBufferLock();
 }
 
-bool sendLiveLedsWs(uint32_t wsClient)
+// live view protocol v1 (1D) and v2 (2D): full frame, every n-th LED if there are too many
+static bool sendLiveLedsWs(AsyncWebSocketClient * wsc)
 {
-  AsyncWebSocketClient * wsc = ws.client(wsClient);
-  if (!wsc || wsc->queueLength() > 0) return false; //only send if queue free
-
   size_t used = strip.getLengthTotal();
 #ifdef ESP8266
   const size_t MAX_LIVE_LEDS_WS = 256U;
@@ -219,19 +322,152 @@ bool sendLiveLedsWs(uint32_t wsClient)
   return true;
 }
 
+// live view protocol v3: binary delta frames
+// header: 'L', 3, flags (bit 0: full frame, bit 1: matrix), n (every n-th LED/row/column), width (uint16 LE), height (uint16 LE)
+// followed by runs of changed pixels: skip (uint16 LE, unchanged pixels since end of previous run), count (uint8), count x RGB
+#define WS_LIVE_V3_HEADER 8
+
+static void *wsLiveRealloc(void *ptr, size_t len) {
+  #ifdef ARDUINO_ARCH_ESP32
+  if (psramSafe && psramFound()) return ps_realloc(ptr, len);
+  #endif
+  return realloc(ptr, len);
+}
+
+// renders current LED colors into shared frame buffer (RGB, white added to RGB channels)
+static bool renderLiveFrame() {
+  unsigned w = strip.getLengthTotal(), h = 1;
+#ifndef WLED_DISABLE_2D
+  if (strip.isMatrix) {
+    // ignore anything behind matrix (i.e. extra strip)
+    w = Segment::maxWidth;
+    h = Segment::maxHeight;
+  }
+#endif
+  unsigned n = 1;
+  while (((w+n-1)/n) * ((h+n-1)/n) > WS_LIVE_MAX_LEDS_V3) n++;
+  wsLiveW = (w+n-1)/n;
+  wsLiveH = (h+n-1)/n;
+  wsLiveN = n;
+  size_t len = wsLiveW * wsLiveH * 3;
+  if (len != wsLiveFrameLen) {
+    uint8_t *frame = (uint8_t*)wsLiveRealloc(wsLiveFrame, len);
+    if (!frame) return false;
+    wsLiveFrame = frame;
+    wsLiveFrameLen = len;
+  }
+  uint8_t *p = wsLiveFrame;
+  for (unsigned y = 0; y < wsLiveH; y++) for (unsigned x = 0; x < wsLiveW; x++) {
+    uint32_t c = strip.getPixelColor(y*n*w + x*n);
+    uint8_t ww = W(c);
+    *p++ = bri ? qadd8(ww, R(c)) : 0;
+    *p++ = bri ? qadd8(ww, G(c)) : 0;
+    *p++ = bri ? qadd8(ww, B(c)) : 0;
+  }
+  return true;
+}
+
+static inline bool livePixelChanged(const uint8_t *cur, const uint8_t *prev, unsigned i) {
+  return !prev || memcmp(cur + i*3, prev + i*3, 3) != 0;
+}
+
+// encodes changed pixels (all if prev is nullptr) as runs, returns encoded size (out may be nullptr to measure)
+static size_t encodeLiveRuns(const uint8_t *cur, const uint8_t *prev, unsigned pixels, uint8_t *out) {
+  size_t size = 0;
+  unsigned last = 0; // end of previous run
+  unsigned i = 0;
+  while (i < pixels) {
+    if (!livePixelChanged(cur, prev, i)) { i++; continue; }
+    unsigned end = i + 1;
+    while (end < pixels && end - i < 255) {
+      if (livePixelChanged(cur, prev, end)) end++;
+      // a single unchanged pixel inside a run is cheaper than a new run header
+      else if (end + 1 < pixels && end + 1 - i < 255 && livePixelChanged(cur, prev, end + 1)) end += 2;
+      else break;
+    }
+    unsigned skip  = i - last;
+    unsigned count = end - i;
+    if (out) {
+      out[size]   = skip & 0xFF;
+      out[size+1] = skip >> 8;
+      out[size+2] = count;
+      memcpy(out + size + 3, cur + i*3, count*3);
+    }
+    size += 3 + count*3;
+    last = i = end;
+  }
+  return size;
+}
+
+static bool sendLiveLedsWsV3(AsyncWebSocketClient * wsc, WSLiveClient &cl) {
+  const unsigned pixels = wsLiveW * wsLiveH;
+  const bool keyFrame = !cl.frame || cl.frameLen != wsLiveFrameLen || millis() - cl.lastKey > WS_LIVE_KEYFRAME;
+  if (keyFrame && cl.frameLen != wsLiveFrameLen) {
+    uint8_t *frame = (uint8_t*)wsLiveRealloc(cl.frame, wsLiveFrameLen);
+    if (!frame) return false;
+    cl.frame = frame;
+    cl.frameLen = wsLiveFrameLen;
+  }
+  const uint8_t *prev = keyFrame ? nullptr : cl.frame;
+  size_t len = encodeLiveRuns(wsLiveFrame, prev, pixels, nullptr);
+  if (!keyFrame && len == 0) return true; // nothing changed
+
+  AsyncWebSocketBuffer wsBuf(WS_LIVE_V3_HEADER + len);
+  if (!wsBuf) return false; //out of memory
+  uint8_t* buffer = reinterpret_cast<uint8_t*>(wsBuf.data());
+  if (!buffer) return false; //out of memory
+  buffer[0] = 'L';
+  buffer[1] = 3; //version
+  buffer[2] = (keyFrame ? 0x01 : 0) | (wsLiveH > 1 ? 0x02 : 0);
+  buffer[3] = wsLiveN;
+  buffer[4] = wsLiveW & 0xFF;
+  buffer[5] = wsLiveW >> 8;
+  buffer[6] = wsLiveH & 0xFF;
+  buffer[7] = wsLiveH >> 8;
+  encodeLiveRuns(wsLiveFrame, prev, pixels, buffer + WS_LIVE_V3_HEADER);
+  memcpy(cl.frame, wsLiveFrame, wsLiveFrameLen);
+  if (keyFrame) cl.lastKey = millis();
+
+  wsc->binary(std::move(wsBuf));
+  return true;
+}
+
 void handleWs()
 {
-  if (millis() - wsLastLiveTime > WS_LIVE_INTERVAL)
+  static unsigned long wsLastCleanup = 0;
+  if (millis() - wsLastCleanup > WS_LIVE_INTERVAL)
   {
     #ifdef ESP8266
     ws.cleanupClients(3);
     #else
     ws.cleanupClients();
     #endif
-    bool success = true;
-    if (wsLiveClientId) success = sendLiveLedsWs(wsLiveClientId);
-    wsLastLiveTime = millis();
-    if (!success) wsLastLiveTime -= 20; //try again in 20ms if failed due to non-empty WS queue
+    wsLastCleanup = millis();
+  }
+
+  bool frameRendered = false;
+  for (auto &cl : wsLiveClients) {
+    if (!cl.id || millis() - cl.lastSent < cl.interval) continue;
+    AsyncWebSocketClient * wsc = ws.client(cl.id);
+    if (!wsc) {
+      setLiveClient(cl.id, 0);
+      continue;
+    }
+    cl.lastSent = millis();
+    // adapt frame rate to client: slow down while previous frames are still queued, speed up again when not
+    if (wsc->queueLength() > 0) {
+      cl.interval = min(cl.interval + cl.interval/2, WS_LIVE_INTERVAL_MAX);
+      continue;
+    }
+    if (cl.interval > WS_LIVE_INTERVAL) cl.interval = max(cl.interval - cl.interval/8 - 1, WS_LIVE_INTERVAL);
+    bool success;
+    if (cl.version >= 3) {
+      if (!frameRendered) frameRendered = renderLiveFrame();
+      success = frameRendered && sendLiveLedsWsV3(wsc, cl);
+    } else {
+      success = sendLiveLedsWs(wsc);
+    }
+    if (!success) cl.lastSent -= cl.interval - 20; //try again in 20ms if failed
   }
 }
 
@@ -287,6 +287,7 @@ void getSettingsJS(byte subPage, Print& settingsScript)
     printSetFormCheckbox(settingsScript,PSTR("CR"),strip.cctFromRgb);
     printSetFormValue(settingsScript,PSTR("CB"),strip.cctBlending);
     printSetFormValue(settingsScript,PSTR("FR"),strip.getTargetFps());
+    printSetFormValue(settingsScript,PSTR("NP"),netBusPacing);
     printSetFormValue(settingsScript,PSTR("AW"),Bus::getGlobalAWMode());
     printSetFormCheckbox(settingsScript,PSTR("LD"),useGlobalLedBuffer);
 
@@ -420,11 +421,13 @@ void getSettingsJS(byte subPage, Print& settingsScript)
     printSetFormCheckbox(settingsScript,PSTR("RP"),receiveNotificationPalette);
     printSetFormCheckbox(settingsScript,PSTR("SO"),receiveSegmentOptions);
     printSetFormCheckbox(settingsScript,PSTR("SG"),receiveSegmentBounds);
+    printSetFormCheckbox(settingsScript,PSTR("CK"),clockSyncEnabled);
     printSetFormCheckbox(settingsScript,PSTR("SS"),sendNotifications);
     printSetFormCheckbox(settingsScript,PSTR("SD"),notifyDirect);
     printSetFormCheckbox(settingsScript,PSTR("SB"),notifyButton);
     printSetFormCheckbox(settingsScript,PSTR("SH"),notifyHue);
     printSetFormValue(settingsScript,PSTR("UR"),udpNumRetries);
+    printSetFormCheckbox(settingsScript,PSTR("S2"),syncProtocolV2);
 
     printSetFormCheckbox(settingsScript,PSTR("NL"),nodeListEnabled);
     printSetFormCheckbox(settingsScript,PSTR("NB"),nodeBroadcastEnabled);